@@ -0,0 +1,224 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Generator throughput on wide containers: one array with up to a million
+//   elements, and an array of that many small objects.  The time per node
+//   should stay flat as the width grows; the walk doesn't recurse per
+//   sibling, so neither stack use nor call overhead scales with width.
+//   Compact output is timed and sized against the default pretty layout.
+//   Then an array of long strings, where the time goes on escaping.  Last,
+//   re-encoding a document to compact form through a DataMap and
+//   JsonGenerator, against piping the parser straight into a JsonWriter.
+//
+// Build against the library, for example:
+//   g++ -O2 -std=c++11 -I<pkg include dir> GeneratorBench.cpp
+//     <csaru-json-cpp and csaru-datamap-cpp sources or libraries> -o GeneratorBench
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <csaru-datamap-cpp/csaru-datamap-cpp.hpp>
+#include <csaru-json-cpp/JsonGenerator.hpp>
+#include <csaru-json-cpp/JsonParser.hpp>
+#include <csaru-json-cpp/JsonParserCallbackForDataMap.hpp>
+#include <csaru-json-cpp/JsonWriter.hpp>
+
+namespace {
+
+//=========================================================================
+// {"rows": [...]} with width elements: integers, or objects with a few
+//   fields each.
+std::string MakeWideDocument (std::size_t width, bool objects) {
+    std::string doc = "{\"rows\": [";
+    for (std::size_t i = 0;  i < width;  ++i) {
+        if (i)
+            doc += ",";
+        if (objects) {
+            doc += "{\"id\": " + std::to_string(i);
+            doc += ", \"name\": \"row " + std::to_string(i) + "\"";
+            doc += ", \"active\": true}";
+        }
+        else {
+            doc += std::to_string(i);
+        }
+    }
+    doc += "]}\n";
+    return doc;
+}
+
+//=========================================================================
+// {"rows": [...]} with count strings of about length characters, mostly
+//   plain text with a quote, a newline and a tab mixed in.
+std::string MakeTextDocument (std::size_t count, std::size_t length) {
+    std::string text;
+    while (text.size() < length)
+        text += "The quick brown fox jumps over the lazy dog. ";
+    text += "He said \\\"hello\\\".\\n\\tThe end.";
+
+    std::string doc = "{\"rows\": [";
+    for (std::size_t i = 0;  i < count;  ++i) {
+        if (i)
+            doc += ",";
+        doc += "\"" + text + "\"";
+    }
+    doc += "]}\n";
+    return doc;
+}
+
+//=========================================================================
+// Parses doc into dataMap.
+bool BuildDataMap (const std::string & doc, CSaruDataMap::DataMap * dataMap) {
+    CSaruJson::JsonParserCallbackForDataMap callback(dataMap->GetMutator());
+    CSaruJson::JsonParser                   parser;
+    return parser.ParseBuffer(doc.data(), doc.size(), &callback) && parser.FinishData();
+}
+
+//=========================================================================
+// Best of several runs at parsing doc and writing it out compact, with or
+//   without a DataMap in between.
+double ReencodeMegabytesPerSecond (const std::string & doc, bool throughDataMap) {
+    using Clock = std::chrono::steady_clock;
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 5;  ++run) {
+        std::string json;
+
+        const auto start = Clock::now();
+        if (throughDataMap) {
+            CSaruDataMap::DataMap dataMap;
+            BuildDataMap(doc, &dataMap);
+            CSaruDataMap::DataMapReader reader = dataMap.GetReader();
+            CSaruJson::JsonGenerator::WriteToString(&reader, &json, false, CSaruJson::JsonFormat::Compact());
+        }
+        else {
+            CSaruJson::JsonStringOutput output(&json);
+            CSaruJson::JsonWriter       writer(&output, CSaruJson::JsonFormat::Compact());
+            CSaruJson::JsonParser       parser;
+            parser.ParseBuffer(doc.data(), doc.size(), &writer);
+            parser.FinishData();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+
+    return double(doc.size()) / bestSeconds / (1024.0 * 1024.0);
+}
+
+//=========================================================================
+// Best of several runs, to keep noise from other processes down.  Returns
+//   nanoseconds per node written; *outputSize gets the size of the JSON.
+double NanosecondsPerNode (
+    CSaruDataMap::DataMap &                  dataMap,
+    std::size_t                              nodes,
+    bool                                     exactSize,
+    const CSaruJson::JsonGenerator::Format & format,
+    std::size_t *                            outputSize
+) {
+    using Clock = std::chrono::steady_clock;
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 5;  ++run) {
+        CSaruDataMap::DataMapReader reader = dataMap.GetReader();
+        std::string                 json;
+
+        const auto start = Clock::now();
+        CSaruJson::JsonGenerator::WriteToString(&reader, &json, exactSize, format);
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        *outputSize = json.size();
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+
+    return bestSeconds * 1e9 / double(nodes);
+}
+
+} // namespace
+
+//=========================================================================
+int main () {
+    const std::size_t widths[] = { 1000, 10000, 100000, 1000000 };
+
+    const CSaruJson::JsonGenerator::Format pretty;
+    const CSaruJson::JsonGenerator::Format compact = CSaruJson::JsonGenerator::Format::Compact();
+
+    std::printf(
+        "%-8s %10s %12s %12s %16s %16s %16s\n",
+        "shape", "width", "pretty", "compact", "growing", "exact size", "compact"
+    );
+    for (int objects = 0;  objects < 2;  ++objects) {
+        for (std::size_t width : widths) {
+            const std::string doc = MakeWideDocument(width, objects != 0);
+
+            CSaruDataMap::DataMap dataMap;
+            if (!BuildDataMap(doc, &dataMap)) {
+                std::fprintf(stderr, "failed to parse the %zu wide document\n", width);
+                return 1;
+            }
+
+            // the root, the array, and per element one node (or four)
+            const std::size_t nodes = 2 + width * (objects ? 4 : 1);
+            std::size_t       prettySize;
+            std::size_t       compactSize;
+            const double      growing  = NanosecondsPerNode(dataMap, nodes, false, pretty, &prettySize);
+            const double      exact    = NanosecondsPerNode(dataMap, nodes, true, pretty, &prettySize);
+            const double      minified = NanosecondsPerNode(dataMap, nodes, false, compact, &compactSize);
+            std::printf(
+                "%-8s %10zu %12zu %12zu %10.1f ns/node %10.1f ns/node %10.1f ns/node\n",
+                objects ? "objects" : "ints",
+                width,
+                prettySize,
+                compactSize,
+                growing,
+                exact,
+                minified
+            );
+        }
+    }
+
+    // long strings
+    const std::size_t     textCount = 20000;
+    CSaruDataMap::DataMap textMap;
+    if (!BuildDataMap(MakeTextDocument(textCount, 1000), &textMap)) {
+        std::fprintf(stderr, "failed to parse the text document\n");
+        return 1;
+    }
+    std::size_t  textSize;
+    const double textNanoseconds = NanosecondsPerNode(textMap, textCount, false, compact, &textSize);
+    std::printf(
+        "\n%zu strings of about 1KB: %.1f MB/s compact\n",
+        textCount,
+        double(textSize) / (textNanoseconds * double(textCount) * 1e-9) / (1024.0 * 1024.0)
+    );
+
+    // re-encoding
+    const std::string reencodeDoc = MakeWideDocument(100000, true);
+    std::printf(
+        "re-encoding %zu bytes to compact: %.1f MB/s through a DataMap, %.1f MB/s parser to JsonWriter\n",
+        reencodeDoc.size(),
+        ReencodeMegabytesPerSecond(reencodeDoc, true),
+        ReencodeMegabytesPerSecond(reencodeDoc, false)
+    );
+
+    return 0;
+}
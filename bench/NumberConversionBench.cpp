@@ -0,0 +1,245 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Number conversion throughput: the C library's atoi()/atof() and
+//   snprintf() against JsonNumbers, and numbers per second through the
+//   whole parser on a numeric-heavy document, with and without deferred
+//   numbers.
+//
+// Build against the library, for example:
+//   g++ -O2 -std=c++11 -I<pkg include dir> NumberConversionBench.cpp
+//     <csaru-json-cpp sources or library> -o NumberConversionBench
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <csaru-json-cpp/JsonNumbers.hpp>
+#include <csaru-json-cpp/JsonParser.hpp>
+
+namespace {
+
+//=========================================================================
+// Sums what it's given, so the optimizer can't throw the parse away.
+struct SummingCallback : CSaruJson::JsonParser::CallbackInterface {
+    std::size_t numbers;
+    double      sum;
+
+    SummingCallback () : numbers(0), sum(0.0) {}
+
+    virtual void BeginObject (const char *, std::size_t)                            {}
+    virtual void EndObject ()                                                       {}
+    virtual void BeginArray (const char *, std::size_t)                             {}
+    virtual void EndArray ()                                                        {}
+    virtual void GotString (const char *, std::size_t, const char *, std::size_t)   {}
+    virtual void GotFloat (const char *, std::size_t, float value)                  { ++numbers;  sum += value; }
+    virtual void GotInteger (const char *, std::size_t, int value)                  { ++numbers;  sum += value; }
+    virtual void GotBoolean (const char *, std::size_t, bool)                       {}
+    virtual void GotNull (const char *, std::size_t)                                {}
+
+    // deferred numbers: only look at the text
+    virtual void GotNumberRaw (
+        const char *,
+        std::size_t,
+        const char *                      text,
+        std::size_t                       textLen,
+        CSaruJson::JsonParser::NumberKind
+    ) {
+        ++numbers;
+        sum += text[textLen - 1];
+    }
+};
+
+//=========================================================================
+// Telemetry-like numbers: counters, readings with a few decimals, and
+//   scientific notation.  exponents controls whether the last kind is used;
+//   atof() handles it either way, the old parser rejected it.
+std::vector<std::string> MakeNumbers (std::size_t count, bool exponents) {
+    std::mt19937_64 random(12345);
+    std::vector<std::string> numbers;
+    numbers.reserve(count);
+
+    char text[64];
+    for (std::size_t i = 0;  i < count;  ++i) {
+        switch (random() % (exponents ? 3 : 2)) {
+            case 0:
+                std::snprintf(text, sizeof(text), "%d", int(random() % 2000000) - 1000000);
+                break;
+            case 1:
+                std::snprintf(text, sizeof(text), "%.4f", double(random() % 10000000) / 1000.0 - 5000.0);
+                break;
+            default:
+                std::snprintf(text, sizeof(text), "%.6e", double(random() % 1000000) * 1e-9);
+                break;
+        }
+        numbers.push_back(text);
+    }
+    return numbers;
+}
+
+//=========================================================================
+template <typename Function>
+double NumbersPerSecond (std::size_t count, Function function) {
+    using Clock = std::chrono::steady_clock;
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 7;  ++run) {
+        const auto start = Clock::now();
+        function();
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+    return double(count) / bestSeconds;
+}
+
+//=========================================================================
+void BenchConversion (const std::vector<std::string> & numbers) {
+    volatile double sink = 0.0;
+
+    const double libc = NumbersPerSecond(numbers.size(), [&] {
+        double sum = 0.0;
+        for (const std::string & number : numbers) {
+            if (number.find_first_of(".eE") == std::string::npos)
+                sum += std::atoi(number.c_str());
+            else
+                sum += std::atof(number.c_str());
+        }
+        sink = sum;
+    });
+
+    const double json = NumbersPerSecond(numbers.size(), [&] {
+        double sum = 0.0;
+        for (const std::string & number : numbers) {
+            double value = 0.0;
+            CSaruJson::JsonNumbers::ParseDouble(number.data(), number.size(), &value);
+            sum += value;
+        }
+        sink = sum;
+    });
+
+    (void)sink;
+    std::printf("%-28s %8.1f M/s\n", "atoi() / atof()", libc / 1e6);
+    std::printf("%-28s %8.1f M/s\n", "JsonNumbers::ParseDouble()", json / 1e6);
+}
+
+//=========================================================================
+// The other direction: snprintf() against JsonNumbers' formatters.  "%.17g"
+//   is what it takes for snprintf() to round-trip a double; "%.9g" a float.
+void BenchFormatting (const std::vector<std::string> & numbers) {
+    std::vector<double> values;
+    values.reserve(numbers.size());
+    for (const std::string & number : numbers)
+        values.push_back(std::atof(number.c_str()));
+
+    volatile std::size_t sink = 0;
+    char                 text[64];
+
+    const double libcDouble = NumbersPerSecond(values.size(), [&] {
+        std::size_t length = 0;
+        for (double value : values)
+            length += std::size_t(std::snprintf(text, sizeof(text), "%.17g", value));
+        sink = length;
+    });
+    const double jsonDouble = NumbersPerSecond(values.size(), [&] {
+        std::size_t length = 0;
+        for (double value : values)
+            length += CSaruJson::JsonNumbers::DoubleToText(value, text);
+        sink = length;
+    });
+    const double libcFloat = NumbersPerSecond(values.size(), [&] {
+        std::size_t length = 0;
+        for (double value : values)
+            length += std::size_t(std::snprintf(text, sizeof(text), "%.9g", double(float(value))));
+        sink = length;
+    });
+    const double jsonFloat = NumbersPerSecond(values.size(), [&] {
+        std::size_t length = 0;
+        for (double value : values)
+            length += CSaruJson::JsonNumbers::FloatToText(float(value), text);
+        sink = length;
+    });
+    const double libcInt = NumbersPerSecond(values.size(), [&] {
+        std::size_t length = 0;
+        for (double value : values)
+            length += std::size_t(std::snprintf(text, sizeof(text), "%d", int(value)));
+        sink = length;
+    });
+    const double jsonInt = NumbersPerSecond(values.size(), [&] {
+        std::size_t length = 0;
+        for (double value : values)
+            length += CSaruJson::JsonNumbers::Int64ToText(int(value), text);
+        sink = length;
+    });
+
+    (void)sink;
+    std::printf("%-28s %8.1f M/s\n", "snprintf(\"%.17g\")", libcDouble / 1e6);
+    std::printf("%-28s %8.1f M/s\n", "JsonNumbers::DoubleToText()", jsonDouble / 1e6);
+    std::printf("%-28s %8.1f M/s\n", "snprintf(\"%.9g\")", libcFloat / 1e6);
+    std::printf("%-28s %8.1f M/s\n", "JsonNumbers::FloatToText()", jsonFloat / 1e6);
+    std::printf("%-28s %8.1f M/s\n", "snprintf(\"%d\")", libcInt / 1e6);
+    std::printf("%-28s %8.1f M/s\n", "JsonNumbers::Int64ToText()", jsonInt / 1e6);
+}
+
+//=========================================================================
+void BenchParser (const std::vector<std::string> & numbers, const char * name, bool deferred) {
+    std::string doc = "{\"samples\":[";
+    for (std::size_t i = 0;  i < numbers.size();  ++i) {
+        if (i)
+            doc += ',';
+        doc += numbers[i];
+    }
+    doc += "]}";
+
+    CSaruJson::JsonParser parser;
+    parser.SetDeferredNumbers(deferred);
+    SummingCallback       callback;
+    std::string           buffer(1 << 16, '\0');
+
+    const double rate = NumbersPerSecond(numbers.size(), [&] {
+        std::FILE * file = fmemopen(const_cast<char *>(doc.data()), doc.size(), "r");
+        parser.ParseEntireFile(file, &buffer[0], buffer.size(), &callback);
+        std::fclose(file);
+    });
+    std::printf("%-28s %8.1f M/s\n", name, rate / 1e6);
+}
+
+} // namespace
+
+//=========================================================================
+int main () {
+    const std::size_t count = 1000000;
+
+    std::printf("conversion only, numbers/sec\n");
+    BenchConversion(MakeNumbers(count, true));
+
+    std::printf("\nformatting, numbers/sec\n");
+    BenchFormatting(MakeNumbers(count, true));
+
+    std::printf("\nwhole parser, numbers/sec\n");
+    BenchParser(MakeNumbers(count, false), "without exponents", false);
+    BenchParser(MakeNumbers(count, true), "with exponents", false);
+    BenchParser(MakeNumbers(count, true), "with exponents, deferred", true);
+    return 0;
+}
@@ -0,0 +1,359 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Parse throughput, with and without structural indexing, and with events
+//   dispatched virtually (JsonParser) or statically (BasicJsonParser).
+//
+// Build against the library, for example:
+//   g++ -O2 -std=c++11 -I<pkg include dir> ParseThroughputBench.cpp
+//     <csaru-json-cpp sources or library> -pthread -o ParseThroughputBench
+
+#include <algorithm> // min()
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <csaru-json-cpp/BasicJsonParser.hpp>
+#include <csaru-json-cpp/JsonParser.hpp>
+#include <csaru-json-cpp/ParallelLineParser.hpp>
+
+namespace {
+
+//=========================================================================
+// Counts events, so the optimizer can't throw the parse away.
+struct CountingCallback : CSaruJson::JsonParser::CallbackInterface {
+    std::size_t events;
+
+    CountingCallback () : events(0) {}
+
+    virtual void BeginObject (const char *, std::size_t)                            { ++events; }
+    virtual void EndObject ()                                                       { ++events; }
+    virtual void BeginArray (const char *, std::size_t)                             { ++events; }
+    virtual void EndArray ()                                                        { ++events; }
+    virtual void GotString (const char *, std::size_t, const char *, std::size_t)   { ++events; }
+    virtual void GotFloat (const char *, std::size_t, float)                        { ++events; }
+    virtual void GotInteger (const char *, std::size_t, int)                        { ++events; }
+    virtual void GotBoolean (const char *, std::size_t, bool)                       { ++events; }
+    virtual void GotNull (const char *, std::size_t)                                { ++events; }
+};
+
+//=========================================================================
+// The same, for BasicJsonParser; calls can be inlined.
+struct CountingHandler : CSaruJson::JsonHandlerBase<CountingHandler> {
+    std::size_t events;
+
+    CountingHandler () : events(0) {}
+
+    void BeginObject (const char *, std::size_t)                            { ++events; }
+    void EndObject ()                                                       { ++events; }
+    void BeginArray (const char *, std::size_t)                             { ++events; }
+    void EndArray ()                                                        { ++events; }
+    void GotString (const char *, std::size_t, const char *, std::size_t)   { ++events; }
+    void GotFloat (const char *, std::size_t, float)                        { ++events; }
+    void GotInteger (const char *, std::size_t, int)                        { ++events; }
+    void GotBoolean (const char *, std::size_t, bool)                       { ++events; }
+    void GotNull (const char *, std::size_t)                                { ++events; }
+
+    // for ParallelLineParser
+    void BeginChunk (std::size_t) {}
+    void EndChunk (std::size_t) {}
+};
+
+//=========================================================================
+// An array of records.  indent controls pretty-printing (0 for compact),
+//   textLength the length of each record's free-text field.
+std::string MakeDocument (std::size_t records, int indent, std::size_t textLength) {
+    const std::string pad1 = indent ? "\n" + std::string(indent, ' ')     : "";
+    const std::string pad2 = indent ? "\n" + std::string(indent * 2, ' ') : "";
+    const std::string pad3 = indent ? "\n" + std::string(indent * 3, ' ') : "";
+    const std::string text(textLength, 'x');
+
+    std::string doc = "{" + pad1 + "\"records\": [";
+    for (std::size_t i = 0;  i < records;  ++i) {
+        doc += i ? "," + pad2 + "{" : pad2 + "{";
+        doc += pad3 + "\"id\": " + std::to_string(i) + ",";
+        doc += pad3 + "\"name\": \"record number " + std::to_string(i) + "\",";
+        doc += pad3 + "\"active\": true,";
+        doc += pad3 + "\"text\": \"" + text + "\\n\"";
+        doc += pad2 + "}";
+    }
+    doc += pad1 + "]\n}\n";
+    return doc;
+}
+
+//=========================================================================
+// JSON Lines: one compact record per line.
+std::string MakeLines (std::size_t records) {
+    std::string lines;
+    for (std::size_t i = 0;  i < records;  ++i) {
+        lines += "{\"id\": " + std::to_string(i);
+        lines += ", \"name\": \"record number " + std::to_string(i) + "\"";
+        lines += ", \"active\": true, \"score\": " + std::to_string(i % 1000) + ".5}\n";
+    }
+    return lines;
+}
+
+//=========================================================================
+// Best of several runs, to keep noise from other processes down.
+template <typename Parser, typename Callback>
+double MegabytesPerSecond (const std::string & doc, std::size_t bufferSize, bool indexing) {
+    using Clock = std::chrono::steady_clock;
+
+    Parser parser;
+    parser.SetStructuralIndexing(indexing);
+    Callback callback;
+    std::string      buffer(bufferSize, '\0');
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 7;  ++run) {
+        std::FILE * file = fmemopen(const_cast<char *>(doc.data()), doc.size(), "r");
+        const auto  start = Clock::now();
+        parser.ParseEntireFile(file, &buffer[0], buffer.size(), &callback);
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        std::fclose(file);
+
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+
+    return double(doc.size()) / bestSeconds / (1024.0 * 1024.0);
+}
+
+//=========================================================================
+// JSON Lines, split up and parsed a line at a time with a Reset() before
+//   each, or parsed in one go with multiple documents on.
+double LinesMegabytesPerSecond (const std::string & lines, bool multipleDocuments) {
+    using Clock = std::chrono::steady_clock;
+
+    CSaruJson::BasicJsonParser<CountingHandler> parser;
+    parser.SetMultipleDocuments(multipleDocuments);
+    CountingHandler callback;
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 7;  ++run) {
+        const auto start = Clock::now();
+        if (multipleDocuments) {
+            parser.Reset();
+            parser.ParseBuffer(lines.data(), lines.size(), &callback);
+        }
+        else {
+            for (std::size_t begin = 0;  begin < lines.size();  ) {
+                std::size_t end = lines.find('\n', begin);
+                end = end == std::string::npos ? lines.size() : end + 1;
+                parser.Reset();
+                parser.ParseBuffer(lines.data() + begin, end - begin, &callback);
+                begin = end;
+            }
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+
+    return double(lines.size()) / bestSeconds / (1024.0 * 1024.0);
+}
+
+//=========================================================================
+// JSON Lines, split between workerCount threads.
+double ParallelLinesMegabytesPerSecond (const std::string & lines, std::size_t workerCount) {
+    using Clock = std::chrono::steady_clock;
+
+    CSaruJson::ParallelLineParser<CountingHandler> parser;
+    parser.SetChunkSize(256 * 1024);
+    std::vector<CountingHandler>   callbacks(workerCount);
+    std::vector<CountingHandler *> callbackPointers;
+    for (CountingHandler & callback : callbacks)
+        callbackPointers.push_back(&callback);
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 7;  ++run) {
+        const auto start = Clock::now();
+        parser.Parse(lines.data(), lines.size(), callbackPointers.data(), workerCount);
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+
+    return double(lines.size()) / bestSeconds / (1024.0 * 1024.0);
+}
+
+//=========================================================================
+// Parsing a file from disk, read in chunks or memory-mapped.  scanThreads
+//   classify a mapped file ahead of the parser.
+double FileMegabytesPerSecond (const char * path, std::size_t fileSize, bool mapped, std::size_t scanThreads) {
+    using Clock = std::chrono::steady_clock;
+
+    CSaruJson::BasicJsonParser<CountingHandler> parser;
+    parser.SetStructuralIndexing(true, scanThreads);
+    CountingHandler callback;
+    std::string     buffer(1 << 20, '\0');
+
+    double bestSeconds = 0.0;
+    for (int run = 0;  run < 7;  ++run) {
+        const auto start = Clock::now();
+        if (mapped)
+            parser.ParseMappedFile(path, &callback);
+        else {
+            std::FILE * file = std::fopen(path, "rb");
+            parser.ParseEntireFile(file, &buffer[0], buffer.size(), &callback);
+            std::fclose(file);
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        if (run == 0 || elapsed.count() < bestSeconds)
+            bestSeconds = elapsed.count();
+    }
+
+    return double(fileSize) / bestSeconds / (1024.0 * 1024.0);
+}
+
+//=========================================================================
+// A document read from a slow disk or network filesystem: every read takes
+//   as long as it would at megabytesPerSecond.  (fopencookie() is glibc's.)
+struct SlowSource {
+    const std::string * doc;
+    std::size_t         offset;
+    double              megabytesPerSecond;
+
+    static ssize_t Read (void * cookie, char * buffer, std::size_t size) {
+        SlowSource *      source = static_cast<SlowSource *>(cookie);
+        const std::size_t count  = std::min(size, source->doc->size() - source->offset);
+        std::this_thread::sleep_for(
+            std::chrono::duration<double>(count / (source->megabytesPerSecond * 1024.0 * 1024.0))
+        );
+        std::memcpy(buffer, source->doc->data() + source->offset, count);
+        source->offset += count;
+        return ssize_t(count);
+    }
+};
+
+//=========================================================================
+// Parsing a SlowSource, with and without read-ahead.
+// RETURN: Wall-clock seconds.
+double SlowFileSeconds (const std::string & doc, double megabytesPerSecond, std::size_t readAheadBuffers) {
+    using Clock = std::chrono::steady_clock;
+
+    CSaruJson::BasicJsonParser<CountingHandler> parser;
+    parser.SetStructuralIndexing(true);
+    parser.SetReadAhead(readAheadBuffers);
+    CountingHandler callback;
+    std::string     buffer(1 << 20, '\0');
+
+    SlowSource               source    = { &doc, 0, megabytesPerSecond };
+    cookie_io_functions_t    functions = { &SlowSource::Read, nullptr, nullptr, nullptr };
+    std::FILE *              file      = fopencookie(&source, "r", functions);
+    const auto               start     = Clock::now();
+    parser.ParseEntireFile(file, &buffer[0], buffer.size(), &callback);
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::fclose(file);
+
+    return elapsed.count();
+}
+
+} // namespace
+
+//=========================================================================
+int main () {
+    struct Case {
+        const char * name;
+        std::size_t  records;
+        int          indent;
+        std::size_t  textLength;
+    };
+    const Case cases[] = {
+        { "compact, short strings", 100000, 0,   8 },
+        { "pretty,  short strings", 100000, 4,   8 },
+        { "compact, long strings ",  20000, 0, 500 },
+        { "pretty,  long strings ",  20000, 4, 500 },
+    };
+    const std::size_t bufferSizes[] = { 64, 4096, 1 << 20 };
+
+    typedef CSaruJson::JsonParser                         VirtualParser;
+    typedef CSaruJson::BasicJsonParser<CountingHandler> StaticParser;
+
+    std::printf(
+        "%-24s %10s %12s %12s %12s\n",
+        "document", "buffer", "bytewise", "indexed", "static+index"
+    );
+    for (const Case & c : cases) {
+        const std::string doc = MakeDocument(c.records, c.indent, c.textLength);
+        for (std::size_t bufferSize : bufferSizes) {
+            std::printf(
+                "%-24s %10zu %7.1f MB/s %7.1f MB/s %7.1f MB/s\n",
+                c.name,
+                bufferSize,
+                MegabytesPerSecond<VirtualParser, CountingCallback>(doc, bufferSize, false),
+                MegabytesPerSecond<VirtualParser, CountingCallback>(doc, bufferSize, true),
+                MegabytesPerSecond<StaticParser, CountingHandler>(doc, bufferSize, true)
+            );
+        }
+    }
+
+    const std::string lines = MakeLines(500000);
+    std::printf(
+        "\nJSON Lines: %.1f MB/s a line at a time, %.1f MB/s as multiple documents\n",
+        LinesMegabytesPerSecond(lines, false),
+        LinesMegabytesPerSecond(lines, true)
+    );
+    const std::size_t workerCount = CSaruJson::ParallelLineParserBase::DefaultWorkerCount();
+    std::printf(
+        "JSON Lines: %.1f MB/s on 1 worker, %.1f MB/s on %zu\n",
+        ParallelLinesMegabytesPerSecond(lines, 1),
+        ParallelLinesMegabytesPerSecond(lines, workerCount),
+        workerCount
+    );
+
+    // the largest document, from a (probably cached) file
+    const char *      path = "ParseThroughputBench.tmp.json";
+    const std::string doc  = MakeDocument(400000, 4, 8);
+    std::FILE *       file = std::fopen(path, "wb");
+    if (file == nullptr)
+        return 1;
+    std::fwrite(doc.data(), 1, doc.size(), file);
+    std::fclose(file);
+
+    std::printf(
+        "\n%zu byte file: %.1f MB/s read in 1MB chunks, %.1f MB/s mapped, %.1f MB/s mapped with %zu scan threads\n",
+        doc.size(),
+        FileMegabytesPerSecond(path, doc.size(), false, 0),
+        FileMegabytesPerSecond(path, doc.size(), true, 0),
+        FileMegabytesPerSecond(path, doc.size(), true, workerCount),
+        workerCount
+    );
+    std::remove(path);
+
+    // the same document, arriving slowly
+    const double rates[] = { 100.0, 300.0 };
+    for (double rate : rates) {
+        std::printf(
+            "arriving at %.0f MB/s: %.2f s plain, %.2f s reading ahead (4 buffers)\n",
+            rate,
+            SlowFileSeconds(doc, rate, 0),
+            SlowFileSeconds(doc, rate, 4)
+        );
+    }
+
+    return 0;
+}
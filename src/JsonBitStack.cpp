@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring> // memcpy()
+
+#include "exported/JsonBitStack.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+JsonBitStack::JsonBitStack ()
+    : m_inline(0)
+    , m_spill(nullptr)
+    , m_spillWords(0)
+    , m_size(0)
+{}
+
+//=========================================================================
+JsonBitStack::~JsonBitStack () {
+    delete [] m_spill;
+}
+
+//=========================================================================
+void JsonBitStack::PushSpilled (bool value) {
+    const std::size_t index = m_size - 64;
+    const std::size_t word  = index / 64;
+
+    if (word >= m_spillWords) {
+        const std::size_t newWords = m_spillWords ? m_spillWords * 2 : 1;
+        std::uint64_t *   newSpill = new std::uint64_t[newWords]();
+        if (m_spill) {
+            memcpy(newSpill, m_spill, m_spillWords * sizeof(std::uint64_t));
+            delete [] m_spill;
+        }
+        m_spill      = newSpill;
+        m_spillWords = newWords;
+    }
+
+    m_spill[word] = SetBit(m_spill[word], index % 64, value);
+}
+
+} // namespace CSaruJson
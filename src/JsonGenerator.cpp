@@ -18,7 +18,11 @@ freely, subject to the following restrictions:
 3. This notice may not be removed or altered from any source distribution.
 */
 
+#include <cstring>
+#include <vector>
+
 #include "exported/JsonGenerator.hpp"
+#include "exported/JsonOutput.hpp"
 
 #if _MSC_VER > 1000
     #pragma warning(push)
@@ -29,7 +33,11 @@ freely, subject to the following restrictions:
 namespace CSaruJson {
 
 //=========================================================================
-bool JsonGenerator::WriteToFile (CSaruDataMap::DataMapReader * reader, char const * filename) {
+bool JsonGenerator::WriteToFile (
+    CSaruDataMap::DataMapReader * reader,
+    char const *                  filename,
+    const Format &                format
+) {
     // check for NULL reader
     if (reader == NULL) {
         #ifdef _DEBUG
@@ -54,14 +62,17 @@ bool JsonGenerator::WriteToFile (CSaruDataMap::DataMapReader * reader, char cons
         return false;
     }
 
-    const bool writeResult = WriteToStream(reader, file);
+    const bool writeResult = WriteToStream(reader, file, format);
 
-    fclose(file);
-    return writeResult;
+    return (fclose(file) == 0) && writeResult;
 }
 
 //=========================================================================
-bool JsonGenerator::WriteToStream (CSaruDataMap::DataMapReader * reader, std::FILE * file) {
+bool JsonGenerator::WriteToStream (
+    CSaruDataMap::DataMapReader * reader,
+    std::FILE *                   file,
+    const Format &                format
+) {
     // check for NULL reader
     if (reader == NULL) {
         #ifdef _DEBUG
@@ -78,125 +89,199 @@ bool JsonGenerator::WriteToStream (CSaruDataMap::DataMapReader * reader, std::FI
         return false;
     }
 
-    const bool writeResult = WriteJsonToFile(file, reader, false);
-    return writeResult;
+    JsonFileOutput output(file);
+    return WriteToOutput(reader, &output, format);
 }
 
 //=========================================================================
-bool JsonGenerator::WriteIndent (std::FILE * file, int indentAmount) {
-    for (int i = 0;  i < indentAmount;  ++i)
-        fprintf(file, " ");
-    return true;
+bool JsonGenerator::WriteToOutput (
+    CSaruDataMap::DataMapReader * reader,
+    JsonOutput *                  output,
+    const Format &                format
+) {
+    // check for NULL reader
+    if (reader == NULL) {
+        #ifdef _DEBUG
+            fprintf(stderr, "JsonGenerator::WriteToOutput() called, but reader == NULL.\n");
+        #endif
+        return false;
+    }
+
+    // check for NULL output
+    if (output == NULL) {
+        #ifdef _DEBUG
+            fprintf(stderr, "JsonGenerator::WriteToOutput() was given a NULL output.\n");
+        #endif
+        return false;
+    }
+
+    const bool writeResult = WriteJson(output, reader, format);
+    return output->Flush() && writeResult;
 }
 
 //=========================================================================
-bool JsonGenerator::WriteJsonToFile (
-    std::FILE *                     file,
+bool JsonGenerator::WriteToString (
     CSaruDataMap::DataMapReader * reader,
-    bool                            currentNodeWritesName
+    std::string *                 str,
+    bool                          exactSize,
+    const Format &                format
 ) {
-    // indent
-    WriteIndent(file, reader->GetCurrentDepth() * 2);
-    // write name if node isn't root, and its parent isn't an array
-    if (currentNodeWritesName) {
-        //fprintf(file, "\"%s\": ", reader->ReadName());
-        fprintf(file, "\"");
-        WriteEscapedStringToFile(file, reader->ReadName());
-        fprintf(file, "\": ");
-    }
-    // write data based on current node type
-    switch (reader->GetCurrentNode()->GetType()) {
-		case CSaruDataMap::DataNode::Type::Unused: // may want to error here instead
-        case CSaruDataMap::DataNode::Type::Null: {
-            fprintf(file, "null");
-        } break;
-
-        case CSaruDataMap::DataNode::Type::Object: {
-            fprintf(file, "{\n");
-            // objects tend to have children, print them if this one has any
-            if (reader->GetCurrentNode()->HasChildren()) {
-                reader->ToFirstChild();
-                /*bool result =*/ WriteJsonToFile(file, reader, true);
-                reader->PopNode();
-            }
-            // terminate object
-            WriteIndent(file, reader->GetCurrentDepth() * 2);
-        fprintf(file, "}");
-        } break;
-
-        case CSaruDataMap::DataNode::Type::Array: {
-            fprintf(file, "[\n");
-            // arrays tend to have children, print them if this one has any
-            if (reader->GetCurrentNode()->HasChildren()) {
-                reader->ToFirstChild();
-                /*bool result =*/ WriteJsonToFile(file, reader, false);
-                reader->PopNode();
-            }
-            // terminate array
-            WriteIndent(file, reader->GetCurrentDepth() * 2);
-            fprintf(file, "]");
-        } break;
-
-        case CSaruDataMap::DataNode::Type::Bool: {
-            if (reader->ReadBool())
-                fprintf(file, "true");
-            else
-                fprintf(file, "false");
-        } break;
-
-        case CSaruDataMap::DataNode::Type::Int: {
-            fprintf(file, "%d", reader->ReadInt());
-        } break;
-
-        case CSaruDataMap::DataNode::Type::Float: {
-            fprintf(file, "%f", reader->ReadFloat());
-        } break;
-
-        case CSaruDataMap::DataNode::Type::String: {
-            fprintf(file, "\"");
-            WriteEscapedStringToFile(file, reader->ReadString());
-            fprintf(file, "\"");
-        } break;
+    // check for NULL reader
+    if (reader == NULL) {
+        #ifdef _DEBUG
+            fprintf(stderr, "JsonGenerator::WriteToString() called, but reader == NULL.\n");
+        #endif
+        return false;
     }
 
-    // write siblings, if there are any
-    if (reader->ToNextSibling().IsValid()) {
-        fprintf(file, ",\n");
-        if (!WriteJsonToFile(file, reader, currentNodeWritesName))
-            return false;
+    // check for NULL string
+    if (str == NULL) {
+        #ifdef _DEBUG
+            fprintf(stderr, "JsonGenerator::WriteToString() was given a NULL string.\n");
+        #endif
+        return false;
     }
-    // otherwise, just terminate the current line
-    else {
-        fprintf(file, "\n");
+
+    if (!exactSize) {
+        JsonStringOutput output(str);
+        return WriteToOutput(reader, &output, format);
     }
 
+    // count on a copy, so the real reader still starts where it should
+    CSaruDataMap::DataMapReader countingReader(*reader);
+    const std::size_t size   = ComputeSize(&countingReader, format);
+    const std::size_t offset = str->size();
+    str->resize(offset + size);
+
+    JsonSpanOutput output(&(*str)[0] + offset, size);
+    const bool writeResult = WriteToOutput(reader, &output, format);
+    // output.Size() is 0 if the data grew between passes; drop the partial write
+    str->resize(offset + output.Size());
+    return writeResult && output.Size() == size;
+}
+
+//=========================================================================
+std::size_t JsonGenerator::ComputeSize (CSaruDataMap::DataMapReader * reader, const Format & format) {
+    if (reader == NULL)
+        return 0;
+
+    JsonCountingOutput output;
+    WriteJson(&output, reader, format);
+    return output.Count();
+}
+
+//=========================================================================
+bool JsonGenerator::WriteIndent (JsonOutput * output, int depth, const Format & format) {
+    if (!format.compact && depth > 0 && format.indentWidth > 0)
+        output->WriteRepeated(format.indentChar, std::size_t(depth) * std::size_t(format.indentWidth));
     return true;
 }
 
 //=========================================================================
-void JsonGenerator::WriteEscapedStringToFile (std::FILE * file, const char * string) {
-    while (*string) {
-        switch (*string) {
-            case '"':  fprintf(file, "\\\"");        break;
-            case '\\': fprintf(file, "\\\\");        break;
-            // backspace
-            case 0x08: fprintf(file, "\\b");         break;
-            // formfeed
-            case 0x0C: fprintf(file, "\\f");         break;
-            // newline
-            case 0x0A: fprintf(file, "\\n");         break;
-            // carriage return
-            case 0x0D: fprintf(file, "\\r");         break;
-            // horizontal tab
-            case 0x09: fprintf(file, "\\t");         break;
-
-            default:   fprintf(file, "%c", *string); break;
+bool JsonGenerator::WriteJson (
+    JsonOutput *                  output,
+    CSaruDataMap::DataMapReader * reader,
+    const Format &                format
+) {
+    // The walk is iterative, so stack use doesn't grow with the data.  The
+    //   reader tracks where we are; all that's kept here is, for each open
+    //   container, whether its children are named (object) or not (array).
+    std::vector<bool> childrenWriteNames;
+    bool              currentNodeWritesName = false;
+
+    for (;;) {
+        // indent
+        WriteIndent(output, reader->GetCurrentDepth(), format);
+        // write name if node isn't root, and its parent isn't an array
+        if (currentNodeWritesName) {
+            output->Put('"');
+            WriteEscapedString(output, reader->ReadName());
+            if (format.compact)
+                output->Write("\":", 2);
+            else
+                output->Write("\": ", 3);
         }
+        // write data based on current node type
+        switch (reader->GetCurrentNode()->GetType()) {
+            case CSaruDataMap::DataNode::Type::Unused: // may want to error here instead
+            case CSaruDataMap::DataNode::Type::Null: {
+                output->Write("null", 4);
+            } break;
 
-        ++string;
+            case CSaruDataMap::DataNode::Type::Object:
+            case CSaruDataMap::DataNode::Type::Array: {
+                const bool isObject = reader->GetCurrentNode()->GetType() == CSaruDataMap::DataNode::Type::Object;
+                output->Put(isObject ? '{' : '[');
+                if (!format.compact)
+                    output->Put('\n');
+                // containers tend to have children; go down and print them
+                //   if this one has any, and close it on the way back up
+                if (reader->GetCurrentNode()->HasChildren()) {
+                    childrenWriteNames.push_back(currentNodeWritesName);
+                    currentNodeWritesName = isObject;
+                    reader->ToFirstChild();
+                    continue;
+                }
+                // terminate empty container
+                WriteIndent(output, reader->GetCurrentDepth(), format);
+                output->Put(isObject ? '}' : ']');
+            } break;
+
+            case CSaruDataMap::DataNode::Type::Bool: {
+                if (reader->ReadBool())
+                    output->Write("true", 4);
+                else
+                    output->Write("false", 5);
+            } break;
+
+            case CSaruDataMap::DataNode::Type::Int: {
+                output->WriteInt64(reader->ReadInt());
+            } break;
+
+            case CSaruDataMap::DataNode::Type::Float: {
+                output->WriteFloat(reader->ReadFloat());
+            } break;
+
+            case CSaruDataMap::DataNode::Type::String: {
+                output->Put('"');
+                WriteEscapedString(output, reader->ReadString());
+                output->Put('"');
+            } break;
+        }
+
+        // The current node is finished.  Move on to its next sibling, or
+        //   if it has none, terminate the line and close its parent; repeat
+        //   for each container finished that way.
+        for (;;) {
+            if (reader->ToNextSibling().IsValid()) {
+                output->Put(',');
+                if (!format.compact)
+                    output->Put('\n');
+                break;
+            }
+
+            if (!format.compact)
+                output->Put('\n');
+            if (childrenWriteNames.empty())
+                return true;
+
+            reader->PopNode();
+            currentNodeWritesName = childrenWriteNames.back();
+            childrenWriteNames.pop_back();
+
+            // terminate container
+            WriteIndent(output, reader->GetCurrentDepth(), format);
+            const bool isObject = reader->GetCurrentNode()->GetType() == CSaruDataMap::DataNode::Type::Object;
+            output->Put(isObject ? '}' : ']');
+        }
     }
 }
 
+//=========================================================================
+void JsonGenerator::WriteEscapedString (JsonOutput * output, const char * string) {
+    output->WriteEscaped(string, strlen(string));
+}
+
 } // namespace CSaruJson
 
 #if _MSC_VER > 1000
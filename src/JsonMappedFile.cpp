@@ -0,0 +1,151 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstdint>
+#include <limits>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include "exported/JsonMappedFile.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+JsonMappedFile::JsonMappedFile ()
+    : m_data(nullptr)
+    , m_size(0)
+{}
+
+//=========================================================================
+JsonMappedFile::~JsonMappedFile () {
+    Close();
+}
+
+#ifdef _WIN32
+
+//=========================================================================
+bool JsonMappedFile::Open (const char * path) {
+    Close();
+
+    HANDLE file = CreateFileA(
+        path,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (
+        GetFileType(file) != FILE_TYPE_DISK                                            ||
+        !GetFileSizeEx(file, &fileSize)                                                 ||
+        fileSize.QuadPart <= 0                                                          ||
+        std::uint64_t(fileSize.QuadPart) > std::numeric_limits<std::size_t>::max()
+    ) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the file open; neither handle is needed after this.
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void * view    = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(file);
+    if (view == nullptr)
+        return false;
+
+    m_data = static_cast<const char *>(view);
+    m_size = std::size_t(fileSize.QuadPart);
+    return true;
+}
+
+//=========================================================================
+void JsonMappedFile::Close () {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#else
+
+//=========================================================================
+bool JsonMappedFile::Open (const char * path) {
+    Close();
+
+    // Check before opening; opening a FIFO would wait for a writer, and
+    //   take data meant for whoever reads it next.
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISREG(info.st_mode))
+        return false;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    if (
+        fstat(fd, &info) != 0                                                       ||
+        info.st_size <= 0                                                           ||
+        std::uint64_t(info.st_size) > std::numeric_limits<std::size_t>::max()
+    ) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file open; the descriptor isn't needed after this.
+    const std::size_t size = std::size_t(info.st_size);
+    void * view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
+
+    // only a hint; fine if it's ignored
+    madvise(view, size, MADV_SEQUENTIAL);
+
+    m_data = static_cast<const char *>(view);
+    m_size = size;
+    return true;
+}
+
+//=========================================================================
+void JsonMappedFile::Close () {
+    if (m_data)
+        munmap(const_cast<char *>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+} // namespace CSaruJson
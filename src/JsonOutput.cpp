@@ -0,0 +1,331 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cerrno>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+#include "exported/JsonNumbers.hpp"
+#include "exported/JsonOutput.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define CSARU_JSON_HAS_SSE2 1
+#   include <emmintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#   endif
+#endif
+
+namespace CSaruJson {
+
+namespace {
+
+//=========================================================================
+// For each byte, 0 if it goes into a JSON string as it is, otherwise the
+//   character after the backslash of its escape ('u' for \u00XX).
+//=========================================================================
+struct EscapeTable {
+    char escapes[256];
+
+    EscapeTable () {
+        memset(escapes, 0, sizeof(escapes));
+        for (int c = 0;  c < 0x20;  ++c)
+            escapes[c] = 'u';
+        escapes[0x08] = 'b';
+        escapes[0x09] = 't';
+        escapes[0x0A] = 'n';
+        escapes[0x0C] = 'f';
+        escapes[0x0D] = 'r';
+        escapes[static_cast<unsigned char>('"')]  = '"';
+        escapes[static_cast<unsigned char>('\\')] = '\\';
+    }
+};
+
+const EscapeTable s_escapeTable;
+
+//=========================================================================
+// Returns the first character in [data, end) that needs escaping, or end.
+//   Strings are mostly plain text, so SSE2 checks 16 bytes at a time, and
+//   the table finishes off the last few.
+inline const char * FindEscape (const char * data, const char * end) {
+#if CSARU_JSON_HAS_SSE2
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control   = _mm_set1_epi8(0x1F);
+    while (end - data >= 16) {
+        const __m128i chars   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        // min(c, 0x1F) == c only for c <= 0x1F, compared unsigned
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)),
+            _mm_cmpeq_epi8(_mm_min_epu8(chars, control), chars)
+        );
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+        if (mask) {
+        #if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return data + index;
+        #else
+            return data + __builtin_ctz(mask);
+        #endif
+        }
+        data += 16;
+    }
+#endif
+
+    while (data != end && !s_escapeTable.escapes[static_cast<unsigned char>(*data)])
+        ++data;
+    return data;
+}
+
+} // namespace
+
+//=========================================================================
+JsonOutput::JsonOutput ()
+    : m_begin(nullptr)
+    , m_cursor(nullptr)
+    , m_end(nullptr)
+    , m_failed(false)
+{}
+
+//=========================================================================
+JsonOutput::~JsonOutput () {
+}
+
+//=========================================================================
+void JsonOutput::WriteSlow (const char * data, std::size_t size) {
+    for (;;) {
+        const std::size_t room = std::size_t(m_end - m_cursor);
+        if (room >= size) {
+            memcpy(m_cursor, data, size);
+            m_cursor += size;
+            return;
+        }
+
+        memcpy(m_cursor, data, room);
+        m_cursor += room;
+        data     += room;
+        size     -= room;
+        Overflow(size);
+    }
+}
+
+//=========================================================================
+void JsonOutput::WriteRepeatedSlow (char c, std::size_t count) {
+    for (;;) {
+        const std::size_t room = std::size_t(m_end - m_cursor);
+        if (room >= count) {
+            memset(m_cursor, c, count);
+            m_cursor += count;
+            return;
+        }
+
+        memset(m_cursor, c, room);
+        m_cursor += room;
+        count    -= room;
+        Overflow(count);
+    }
+}
+
+//=========================================================================
+void JsonOutput::WriteEscaped (const char * string, std::size_t length) {
+    static const char s_hexDigits[] = "0123456789abcdef";
+
+    const char * end = string + length;
+    for (;;) {
+        // copy the run of characters that need no escaping in one go
+        const char * special = FindEscape(string, end);
+        if (special != string)
+            Write(string, std::size_t(special - string));
+        if (special == end)
+            return;
+
+        const unsigned char c      = static_cast<unsigned char>(*special);
+        const char          escape = s_escapeTable.escapes[c];
+        if (escape == 'u') {
+            const char text[6] = { '\\', 'u', '0', '0', s_hexDigits[c >> 4], s_hexDigits[c & 0xF] };
+            Write(text, sizeof(text));
+        }
+        else {
+            const char text[2] = { '\\', escape };
+            Write(text, sizeof(text));
+        }
+
+        string = special + 1;
+    }
+}
+
+//=========================================================================
+void JsonOutput::WriteDouble (double value) {
+    if (char * text = Room(JsonNumbers::s_maxDoubleText)) {
+        m_cursor = text + JsonNumbers::DoubleToText(value, text);
+    }
+    else {
+        char buffer[JsonNumbers::s_maxDoubleText];
+        Write(buffer, JsonNumbers::DoubleToText(value, buffer));
+    }
+}
+
+//=========================================================================
+void JsonOutput::WriteFloat (float value) {
+    if (char * text = Room(JsonNumbers::s_maxFloatText)) {
+        m_cursor = text + JsonNumbers::FloatToText(value, text);
+    }
+    else {
+        char buffer[JsonNumbers::s_maxFloatText];
+        Write(buffer, JsonNumbers::FloatToText(value, buffer));
+    }
+}
+
+//=========================================================================
+void JsonOutput::WriteInt64 (std::int64_t value) {
+    if (char * text = Room(JsonNumbers::s_maxIntText)) {
+        m_cursor = text + JsonNumbers::Int64ToText(value, text);
+    }
+    else {
+        char buffer[JsonNumbers::s_maxIntText];
+        Write(buffer, JsonNumbers::Int64ToText(value, buffer));
+    }
+}
+
+//=========================================================================
+void JsonOutput::WriteUInt64 (std::uint64_t value) {
+    if (char * text = Room(JsonNumbers::s_maxIntText)) {
+        m_cursor = text + JsonNumbers::UInt64ToText(value, text);
+    }
+    else {
+        char buffer[JsonNumbers::s_maxIntText];
+        Write(buffer, JsonNumbers::UInt64ToText(value, buffer));
+    }
+}
+
+//=========================================================================
+bool JsonOutput::Flush () {
+    return !m_failed;
+}
+
+//=========================================================================
+JsonFileOutput::JsonFileOutput (std::FILE * file, std::size_t bufferSize)
+    : m_file(file)
+    , m_buffer(bufferSize ? bufferSize : 1)
+{
+    m_begin  = m_buffer.data();
+    m_cursor = m_begin;
+    m_end    = m_begin + m_buffer.size();
+}
+
+//=========================================================================
+JsonFileOutput::~JsonFileOutput () {
+    Flush();
+}
+
+//=========================================================================
+void JsonFileOutput::Overflow (std::size_t /*needed*/) {
+    Flush();
+}
+
+//=========================================================================
+bool JsonFileOutput::Flush () {
+    const std::size_t size = std::size_t(m_cursor - m_begin);
+    if (size && !m_failed && std::fwrite(m_begin, sizeof(char), size, m_file) != size)
+        m_failed = true;
+
+    m_cursor = m_begin;
+    return !m_failed;
+}
+
+//=========================================================================
+JsonFdOutput::JsonFdOutput (int fd, std::size_t bufferSize)
+    : m_fd(fd)
+    , m_buffer(bufferSize ? bufferSize : 1)
+{
+    m_begin  = m_buffer.data();
+    m_cursor = m_begin;
+    m_end    = m_begin + m_buffer.size();
+}
+
+//=========================================================================
+JsonFdOutput::~JsonFdOutput () {
+    Flush();
+}
+
+//=========================================================================
+void JsonFdOutput::Overflow (std::size_t /*needed*/) {
+    Flush();
+}
+
+//=========================================================================
+bool JsonFdOutput::Flush () {
+    const char * data = m_begin;
+    while (!m_failed && data != m_cursor) {
+        // a short write isn't an error; keep going with the rest
+        #ifdef _WIN32
+            const int written = _write(m_fd, data, unsigned(m_cursor - data));
+        #else
+            const ssize_t written = write(m_fd, data, std::size_t(m_cursor - data));
+        #endif
+        if (written > 0)
+            data += written;
+        else if (written < 0 && errno == EINTR)
+            continue;
+        else
+            m_failed = true;
+    }
+
+    m_cursor = m_begin;
+    return !m_failed;
+}
+
+//=========================================================================
+JsonSpanOutput::JsonSpanOutput (char * buffer, std::size_t capacity) {
+    m_begin  = buffer;
+    m_cursor = buffer;
+    m_end    = buffer + capacity;
+}
+
+//=========================================================================
+void JsonSpanOutput::Overflow (std::size_t /*needed*/) {
+    // out of room; drop the rest
+    m_failed = true;
+    m_begin  = m_overflow;
+    m_cursor = m_overflow;
+    m_end    = m_overflow + sizeof(m_overflow);
+}
+
+//=========================================================================
+JsonCountingOutput::JsonCountingOutput ()
+    : m_count(0)
+{
+    m_begin  = m_scratch;
+    m_cursor = m_scratch;
+    m_end    = m_scratch + sizeof(m_scratch);
+}
+
+//=========================================================================
+void JsonCountingOutput::Overflow (std::size_t /*needed*/) {
+    m_count += std::size_t(m_cursor - m_begin);
+    m_cursor = m_begin;
+}
+
+} // namespace CSaruJson
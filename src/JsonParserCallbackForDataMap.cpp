@@ -27,6 +27,7 @@ namespace CSaruJson {
 //=========================================================================
 JsonParserCallbackForDataMap::JsonParserCallbackForDataMap (const CSaruDataMap::DataMapMutator & mutator)
     : m_mutator(mutator)
+    , m_beganEmpty(false)
 {}
 
 //=========================================================================
@@ -38,6 +39,14 @@ void JsonParserCallbackForDataMap::BeginObject(const char * name, size_t nameLen
 
 //=========================================================================
 void JsonParserCallbackForDataMap::EndObject() {
+    // already at the (childless) object
+    if (m_beganEmpty) {
+        m_beganEmpty = false;
+        if (m_mutator.GetCurrentDepth() >= 2)
+            m_mutator.Walk(1);
+        return;
+    }
+
     // we only want to clean the last child if it was a temporary write-location
     //  created while parsing.  If we've just bubbled back up from lower nodes,
     //  the last child should _not_ be deleted.
@@ -63,6 +72,13 @@ void JsonParserCallbackForDataMap::BeginArray(const char * name, size_t nameLen)
 //=========================================================================
 void JsonParserCallbackForDataMap::EndArray()
 {
+    // already at the (childless) array
+    if (m_beganEmpty) {
+        m_beganEmpty = false;
+        m_mutator.Walk(1);
+        return;
+    }
+
     //m_mutator.ToParent();
     //m_mutator.DeleteLastChildren(1);
 
@@ -79,6 +95,30 @@ void JsonParserCallbackForDataMap::EndArray()
     m_mutator.Walk(1);
 }
 
+//=========================================================================
+void JsonParserCallbackForDataMap::BeginObjectSized(const char * name, size_t nameLen, size_t size) {
+    // Empty containers are common ({} and [] fields), and need no
+    //   write-location child created only to be deleted again.
+    if (size == 0) {
+        m_mutator.WriteNameSecure(name, int(nameLen));
+        m_mutator.SetToObjectType();
+        m_beganEmpty = true;
+        return;
+    }
+    BeginObject(name, nameLen);
+}
+
+//=========================================================================
+void JsonParserCallbackForDataMap::BeginArraySized(const char * name, size_t nameLen, size_t size) {
+    if (size == 0) {
+        m_mutator.WriteNameSecure(name, int(nameLen));
+        m_mutator.SetToArrayType();
+        m_beganEmpty = true;
+        return;
+    }
+    BeginArray(name, nameLen);
+}
+
 //=========================================================================
 void JsonParserCallbackForDataMap::GotString(const char * name, size_t nameLen, const char * value, size_t valueLen) {
   m_mutator.WriteWalkSafe(name, static_cast<int>(nameLen), value, static_cast<int>(valueLen));
@@ -110,7 +150,8 @@ void JsonParserCallbackForDataMap::GotNull(const char * name, size_t nameLen) {
 
 //=========================================================================
 void JsonParserCallbackForDataMap::SetMutator(const CSaruDataMap::DataMapMutator & mutator) {
-    m_mutator = mutator;
+    m_mutator    = mutator;
+    m_beganEmpty = false;
 }
 
 } // namespace CSaruJson
@@ -0,0 +1,121 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "exported/JsonReadAhead.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+JsonReadAhead::JsonReadAhead (std::FILE * file, std::size_t bufferSize, std::size_t bufferCount)
+    : m_file(file)
+    , m_bufferSize(bufferSize ? bufferSize : 1)
+    , m_bufferCount(bufferCount < 2 ? 2 : bufferCount)
+    , m_chunksRead(0)
+    , m_chunksAcquired(0)
+    , m_chunksReleased(0)
+    , m_finished(false)
+    , m_readError(false)
+    , m_stop(false)
+{
+    m_buffers.resize(m_bufferSize * m_bufferCount);
+    m_chunkSizes.resize(m_bufferCount);
+
+    m_thread = std::thread(&JsonReadAhead::ReadChunks, this);
+}
+
+//=========================================================================
+JsonReadAhead::~JsonReadAhead () {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_chunkReleased.notify_one();
+    m_thread.join();
+}
+
+//=========================================================================
+void JsonReadAhead::ReadChunks () {
+    for (;;) {
+        std::size_t buffer;
+        {
+            // wait for a free buffer
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_stop && m_chunksRead - m_chunksReleased == m_bufferCount)
+                m_chunkReleased.wait(lock);
+            if (m_stop)
+                break;
+            buffer = m_chunksRead % m_bufferCount;
+        }
+
+        // read without holding the lock; the buffer is ours until published
+        char * data = &m_buffers[buffer * m_bufferSize];
+        const std::size_t charsThisRead = std::fread(data, sizeof(char), m_bufferSize, m_file);
+        const bool        endOfData     = charsThisRead != m_bufferSize;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (charsThisRead) {
+            m_chunkSizes[buffer] = charsThisRead;
+            ++m_chunksRead;
+        }
+        if (endOfData) {
+            m_readError = std::ferror(m_file) != 0;
+            break;
+        }
+        m_chunkRead.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished = true;
+    }
+    m_chunkRead.notify_one();
+}
+
+//=========================================================================
+bool JsonReadAhead::Acquire (const char ** chunk, std::size_t * chunkSize) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_finished && m_chunksAcquired == m_chunksRead)
+        m_chunkRead.wait(lock);
+    if (m_chunksAcquired == m_chunksRead)
+        return false;
+
+    const std::size_t buffer = m_chunksAcquired % m_bufferCount;
+    *chunk     = &m_buffers[buffer * m_bufferSize];
+    *chunkSize = m_chunkSizes[buffer];
+    ++m_chunksAcquired;
+    return true;
+}
+
+//=========================================================================
+void JsonReadAhead::Release () {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_chunksReleased = m_chunksAcquired;
+    }
+    m_chunkReleased.notify_one();
+}
+
+//=========================================================================
+bool JsonReadAhead::HadReadError () {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_readError;
+}
+
+} // namespace CSaruJson
@@ -0,0 +1,255 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring> // memcpy()
+
+#include "exported/JsonReader.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+void JsonReader::Handler::BeginObject (const char * name, std::size_t name_len) {
+    reader->PushValue(TokenType::BeginObject, name, name_len, nullptr, 0);
+    reader->m_containers.push_back(true);
+}
+
+//=========================================================================
+void JsonReader::Handler::EndObject () {
+    reader->PushEnd(TokenType::EndObject);
+}
+
+//=========================================================================
+void JsonReader::Handler::BeginArray (const char * name, std::size_t name_len) {
+    reader->PushValue(TokenType::BeginArray, name, name_len, nullptr, 0);
+    reader->m_containers.push_back(false);
+}
+
+//=========================================================================
+void JsonReader::Handler::EndArray () {
+    reader->PushEnd(TokenType::EndArray);
+}
+
+//=========================================================================
+void JsonReader::Handler::GotString (
+    const char * name,
+    std::size_t  name_len,
+    const char * value,
+    std::size_t  value_len
+) {
+    reader->PushValue(TokenType::String, name, name_len, value, value_len);
+}
+
+//=========================================================================
+void JsonReader::Handler::GotStringSpan (
+    const char * name,
+    std::size_t  name_len,
+    const char * value,
+    std::size_t  value_len,
+    bool         value_has_escapes
+) {
+    // raw escapes are never kept (see the constructor)
+    (void)value_has_escapes;
+    reader->PushValue(TokenType::String, name, name_len, value, value_len);
+}
+
+//=========================================================================
+void JsonReader::Handler::GotNumberRaw (
+    const char *               name,
+    std::size_t                name_len,
+    const char *               text,
+    std::size_t                text_len,
+    JsonParserBase::NumberKind kind
+) {
+    Token & token = reader->PushValue(TokenType::Number, name, name_len, text, text_len);
+    token.numberKind = kind;
+}
+
+//=========================================================================
+void JsonReader::Handler::GotBoolean (const char * name, std::size_t name_len, bool value) {
+    Token & token = reader->PushValue(TokenType::Boolean, name, name_len, nullptr, 0);
+    token.boolean = value;
+}
+
+//=========================================================================
+void JsonReader::Handler::GotNull (const char * name, std::size_t name_len) {
+    reader->PushValue(TokenType::Null, name, name_len, nullptr, 0);
+}
+
+//=========================================================================
+JsonReader::JsonReader ()
+    : m_chunk(nullptr)
+    , m_chunkSize(0)
+    , m_key(JsonParserBase::s_initialNameCapacity)
+    , m_value(JsonParserBase::s_initialStringCapacity)
+{
+    m_handler.reader = this;
+
+    // Tokens point straight into the chunk when they can, and numbers are
+    //   left for the caller to convert (or not).
+    m_parser.SetZeroCopy(true);
+    m_parser.SetDeferredNumbers(true);
+
+    Reset();
+}
+
+//=========================================================================
+void JsonReader::Reset () {
+    m_parser.Reset();
+
+    m_pendingCount = 0;
+    m_pendingIndex = 0;
+    m_chunk        = nullptr;
+    m_chunkSize    = 0;
+    m_lastType     = TokenType::NeedMoreInput;
+    m_swallowEnd   = false;
+    m_containers.clear();
+}
+
+//=========================================================================
+void JsonReader::Feed (const char * buffer, std::size_t bufferSize) {
+    m_chunk        = buffer;
+    m_chunkSize    = bufferSize;
+    m_pendingCount = 0;
+    m_pendingIndex = 0;
+
+    // Parses up to the first event, if there is one in this chunk.
+    m_parser.ParseBuffer(buffer, bufferSize, &m_handler);
+}
+
+//=========================================================================
+JsonReader::Token JsonReader::Next () {
+    for (;;) {
+        if (m_pendingIndex < m_pendingCount) {
+            m_lastType = m_pending[m_pendingIndex].type;
+            return m_pending[m_pendingIndex++];
+        }
+
+        Token token = Token();
+        JsonParserBase::ErrorStatus status = m_parser.GetErrorCode();
+        if (status >= JsonParserBase::ErrorStatus::Error_Unspecified)
+            token.type = TokenType::Error;
+        else if (status == JsonParserBase::ErrorStatus::Done)
+            token.type = TokenType::EndOfDocument;
+        else if (!m_parser.IsPaused())
+            token.type = TokenType::NeedMoreInput;
+        else {
+            // on to the next event
+            m_pendingCount = 0;
+            m_pendingIndex = 0;
+            m_parser.Resume();
+            continue;
+        }
+
+        m_lastType = token.type;
+        return token;
+    }
+}
+
+//=========================================================================
+bool JsonReader::SkipValue () {
+    switch (m_lastType) {
+        case TokenType::Key: {
+            // The value's token came from the same event, so it's waiting
+            //   right behind the key.
+            TokenType valueType = m_pending[m_pendingIndex++].type;
+            m_lastType = valueType;
+            if (valueType == TokenType::BeginObject || valueType == TokenType::BeginArray) {
+                SkipOpenContainer();
+                m_lastType = valueType == TokenType::BeginObject ? TokenType::EndObject : TokenType::EndArray;
+            }
+        } return true;
+
+        case TokenType::BeginObject:
+            SkipOpenContainer();
+            m_lastType = TokenType::EndObject;
+        return true;
+
+        case TokenType::BeginArray:
+            SkipOpenContainer();
+            m_lastType = TokenType::EndArray;
+        return true;
+
+        default:
+        return false;
+    }
+}
+
+//=========================================================================
+JsonReader::Token & JsonReader::PushValue (
+    TokenType    type,
+    const char * name,
+    std::size_t  nameLen,
+    const char * text,
+    std::size_t  length
+) {
+    // object members are preceded by their key
+    if (!m_containers.empty() && m_containers.back()) {
+        Token & key = m_pending[m_pendingCount++];
+        key        = Token();
+        key.type   = TokenType::Key;
+        key.text   = Keep(&m_key, name, nameLen);
+        key.length = nameLen;
+    }
+
+    Token & token = m_pending[m_pendingCount++];
+    token        = Token();
+    token.type   = type;
+    token.text   = text ? Keep(&m_value, text, length) : nullptr;
+    token.length = length;
+
+    m_parser.Pause();
+    return token;
+}
+
+//=========================================================================
+void JsonReader::PushEnd (TokenType type) {
+    m_containers.pop_back();
+
+    if (m_swallowEnd) {
+        m_swallowEnd = false;
+        return;
+    }
+
+    Token & token = m_pending[m_pendingCount++];
+    token      = Token();
+    token.type = type;
+
+    m_parser.Pause();
+}
+
+//=========================================================================
+const char * JsonReader::Keep (JsonScratchBuffer * buffer, const char * text, std::size_t length) {
+    // still good for as long as the chunk is
+    if (m_chunk && text >= m_chunk && text + length <= m_chunk + m_chunkSize)
+        return text;
+
+    buffer->Reserve(length + 1);
+    memcpy(buffer->Data(), text, length);
+    buffer->Data()[length] = '\0';
+    return buffer->Data();
+}
+
+//=========================================================================
+void JsonReader::SkipOpenContainer () {
+    m_parser.SkipContainer();
+    m_swallowEnd = true;
+}
+
+} // namespace CSaruJson
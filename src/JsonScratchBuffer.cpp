@@ -0,0 +1,58 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring> // memcpy()
+
+#include "exported/JsonScratchBuffer.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+JsonScratchBuffer::JsonScratchBuffer (std::size_t initialCapacity)
+    : m_data(nullptr)
+    , m_capacity(0)
+{
+    // always have somewhere to write a terminating NUL
+    Grow(initialCapacity ? initialCapacity : 1);
+    m_data[0] = '\0';
+}
+
+//=========================================================================
+JsonScratchBuffer::~JsonScratchBuffer () {
+    delete [] m_data;
+}
+
+//=========================================================================
+void JsonScratchBuffer::Grow (std::size_t capacity) {
+    std::size_t newCapacity = m_capacity * 2;
+    if (newCapacity < capacity)
+        newCapacity = capacity;
+
+    char * newData = new char[newCapacity];
+    if (m_data) {
+        memcpy(newData, m_data, m_capacity);
+        delete [] m_data;
+    }
+
+    m_data     = newData;
+    m_capacity = newCapacity;
+}
+
+} // namespace CSaruJson
@@ -0,0 +1,652 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <bitset>
+#include <cstring> // memcpy(), memset()
+
+#include "exported/JsonStructuralIndex.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define CSARU_JSON_HAS_SSE2 1
+#   include <emmintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       define CSARU_JSON_HAS_AVX2 1
+#       define CSARU_JSON_TARGET_AVX2
+#       include <immintrin.h>
+#       include <intrin.h>
+#   elif defined(__GNUC__)
+#       define CSARU_JSON_HAS_AVX2 1
+#       define CSARU_JSON_TARGET_AVX2 __attribute__((target("avx2")))
+#       include <immintrin.h>
+#   endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#endif
+
+namespace CSaruJson {
+
+namespace {
+
+//=========================================================================
+inline unsigned CountTrailingZeros (std::uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    #if defined(_M_X64) || defined(_M_ARM64)
+        _BitScanForward64(&index, bits);
+        return index;
+    #else
+        if (_BitScanForward(&index, static_cast<unsigned long>(bits)))
+            return index;
+        _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+        return index + 32;
+    #endif
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+//=========================================================================
+// Scalar classifier.  Always available, and the reference the vectorized
+//   ones must agree with.
+//=========================================================================
+enum CharClass {
+    CharClass_Quote      = 1 << 0,
+    CharClass_Backslash  = 1 << 1,
+    CharClass_Structural = 1 << 2,
+    CharClass_Whitespace = 1 << 3
+};
+
+struct CharClassTable {
+    unsigned char classes[256];
+
+    CharClassTable () {
+        memset(classes, 0, sizeof(classes));
+        classes[static_cast<unsigned char>('"')]  = CharClass_Quote;
+        classes[static_cast<unsigned char>('\\')] = CharClass_Backslash;
+        classes[static_cast<unsigned char>('{')]  = CharClass_Structural;
+        classes[static_cast<unsigned char>('}')]  = CharClass_Structural;
+        classes[static_cast<unsigned char>('[')]  = CharClass_Structural;
+        classes[static_cast<unsigned char>(']')]  = CharClass_Structural;
+        classes[static_cast<unsigned char>(':')]  = CharClass_Structural;
+        classes[static_cast<unsigned char>(',')]  = CharClass_Structural;
+        classes[static_cast<unsigned char>(' ')]  = CharClass_Whitespace;
+        classes[0x09]                             = CharClass_Whitespace;
+        classes[0x0A]                             = CharClass_Whitespace;
+        classes[0x0D]                             = CharClass_Whitespace;
+    }
+};
+
+const CharClassTable s_charClassTable;
+
+//=========================================================================
+void ClassifyBlocksScalar (const char * data, std::size_t blockCount, JsonBlockMasks * result) {
+    for (std::size_t block = 0;  block < blockCount;  ++block, data += JsonStructuralIndex::s_blockSize) {
+        std::uint64_t quote      = 0;
+        std::uint64_t backslash  = 0;
+        std::uint64_t structural = 0;
+        std::uint64_t whitespace = 0;
+        for (unsigned i = 0;  i < JsonStructuralIndex::s_blockSize;  ++i) {
+            const unsigned classes = s_charClassTable.classes[static_cast<unsigned char>(data[i])];
+            quote      |= std::uint64_t( classes       & 1) << i;
+            backslash  |= std::uint64_t((classes >> 1) & 1) << i;
+            structural |= std::uint64_t((classes >> 2) & 1) << i;
+            whitespace |= std::uint64_t((classes >> 3) & 1) << i;
+        }
+        result[block].quote      = quote;
+        result[block].backslash  = backslash;
+        result[block].structural = structural;
+        result[block].whitespace = whitespace;
+    }
+}
+
+#if CSARU_JSON_HAS_SSE2
+//=========================================================================
+// SSE2 classifier.  Part of the x86-64 baseline, so never needs a CPU check.
+//   '{' and '[' only differ in bit 0x20, as do '}' and ']', so OR-ing that
+//   bit in lets one compare find both.
+//=========================================================================
+inline std::uint64_t Sse2Bits (__m128i a, __m128i b, __m128i c, __m128i d) {
+    return
+        (std::uint64_t(static_cast<unsigned>(_mm_movemask_epi8(a)))      ) |
+        (std::uint64_t(static_cast<unsigned>(_mm_movemask_epi8(b))) << 16) |
+        (std::uint64_t(static_cast<unsigned>(_mm_movemask_epi8(c))) << 32) |
+        (std::uint64_t(static_cast<unsigned>(_mm_movemask_epi8(d))) << 48);
+}
+
+//=========================================================================
+void ClassifyBlocksSse2 (const char * data, std::size_t blockCount, JsonBlockMasks * result) {
+    const __m128i quoteChar      = _mm_set1_epi8('"');
+    const __m128i backslashChar  = _mm_set1_epi8('\\');
+    const __m128i caseBit        = _mm_set1_epi8(0x20);
+    const __m128i openChar       = _mm_set1_epi8('{');
+    const __m128i closeChar      = _mm_set1_epi8('}');
+    const __m128i colonChar      = _mm_set1_epi8(':');
+    const __m128i commaChar      = _mm_set1_epi8(',');
+    const __m128i spaceChar      = _mm_set1_epi8(' ');
+    const __m128i tabChar        = _mm_set1_epi8(0x09);
+    const __m128i lineFeedChar   = _mm_set1_epi8(0x0A);
+    const __m128i carriageReturn = _mm_set1_epi8(0x0D);
+
+    for (std::size_t block = 0;  block < blockCount;  ++block, data += JsonStructuralIndex::s_blockSize) {
+        __m128i quote[4];
+        __m128i backslash[4];
+        __m128i structural[4];
+        __m128i whitespace[4];
+        for (int i = 0;  i < 4;  ++i) {
+            const __m128i chars  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16));
+            const __m128i folded = _mm_or_si128(chars, caseBit);
+            quote[i]      = _mm_cmpeq_epi8(chars, quoteChar);
+            backslash[i]  = _mm_cmpeq_epi8(chars, backslashChar);
+            structural[i] = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, openChar), _mm_cmpeq_epi8(folded, closeChar)),
+                _mm_or_si128(_mm_cmpeq_epi8(chars, colonChar), _mm_cmpeq_epi8(chars, commaChar))
+            );
+            whitespace[i] = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chars, spaceChar), _mm_cmpeq_epi8(chars, tabChar)),
+                _mm_or_si128(_mm_cmpeq_epi8(chars, lineFeedChar), _mm_cmpeq_epi8(chars, carriageReturn))
+            );
+        }
+        result[block].quote      = Sse2Bits(quote[0], quote[1], quote[2], quote[3]);
+        result[block].backslash  = Sse2Bits(backslash[0], backslash[1], backslash[2], backslash[3]);
+        result[block].structural = Sse2Bits(structural[0], structural[1], structural[2], structural[3]);
+        result[block].whitespace = Sse2Bits(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+    }
+}
+#endif // CSARU_JSON_HAS_SSE2
+
+#if CSARU_JSON_HAS_AVX2
+//=========================================================================
+// AVX2 classifier.  Same approach as the SSE2 one, 32 bytes at a time.
+//=========================================================================
+CSARU_JSON_TARGET_AVX2
+inline std::uint64_t Avx2Bits (__m256i low, __m256i high) {
+    return
+        (std::uint64_t(static_cast<unsigned>(_mm256_movemask_epi8(low)))       ) |
+        (std::uint64_t(static_cast<unsigned>(_mm256_movemask_epi8(high))) << 32);
+}
+
+//=========================================================================
+CSARU_JSON_TARGET_AVX2
+void ClassifyBlocksAvx2 (const char * data, std::size_t blockCount, JsonBlockMasks * result) {
+    const __m256i quoteChar      = _mm256_set1_epi8('"');
+    const __m256i backslashChar  = _mm256_set1_epi8('\\');
+    const __m256i caseBit        = _mm256_set1_epi8(0x20);
+    const __m256i openChar       = _mm256_set1_epi8('{');
+    const __m256i closeChar      = _mm256_set1_epi8('}');
+    const __m256i colonChar      = _mm256_set1_epi8(':');
+    const __m256i commaChar      = _mm256_set1_epi8(',');
+    const __m256i spaceChar      = _mm256_set1_epi8(' ');
+    const __m256i tabChar        = _mm256_set1_epi8(0x09);
+    const __m256i lineFeedChar   = _mm256_set1_epi8(0x0A);
+    const __m256i carriageReturn = _mm256_set1_epi8(0x0D);
+
+    for (std::size_t block = 0;  block < blockCount;  ++block, data += JsonStructuralIndex::s_blockSize) {
+        __m256i quote[2];
+        __m256i backslash[2];
+        __m256i structural[2];
+        __m256i whitespace[2];
+        for (int i = 0;  i < 2;  ++i) {
+            const __m256i chars  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i * 32));
+            const __m256i folded = _mm256_or_si256(chars, caseBit);
+            quote[i]      = _mm256_cmpeq_epi8(chars, quoteChar);
+            backslash[i]  = _mm256_cmpeq_epi8(chars, backslashChar);
+            structural[i] = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, openChar), _mm256_cmpeq_epi8(folded, closeChar)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, colonChar), _mm256_cmpeq_epi8(chars, commaChar))
+            );
+            whitespace[i] = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, spaceChar), _mm256_cmpeq_epi8(chars, tabChar)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chars, lineFeedChar), _mm256_cmpeq_epi8(chars, carriageReturn))
+            );
+        }
+        result[block].quote      = Avx2Bits(quote[0], quote[1]);
+        result[block].backslash  = Avx2Bits(backslash[0], backslash[1]);
+        result[block].structural = Avx2Bits(structural[0], structural[1]);
+        result[block].whitespace = Avx2Bits(whitespace[0], whitespace[1]);
+    }
+}
+
+//=========================================================================
+bool CpuSupportsAvx2 () {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    // the CPU must have AVX and OSXSAVE, and the OS must be saving YMM state
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+        return false;
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif // CSARU_JSON_HAS_AVX2
+
+//=========================================================================
+struct Classifier {
+    JsonStructuralIndex::ClassifyFunction function;
+    const char *                          name;
+};
+
+//=========================================================================
+Classifier SelectClassifier () {
+    Classifier result = { ClassifyBlocksScalar, "scalar" };
+#if CSARU_JSON_HAS_SSE2
+    result.function = ClassifyBlocksSse2;
+    result.name     = "sse2";
+#endif
+#if CSARU_JSON_HAS_AVX2
+    if (CpuSupportsAvx2()) {
+        result.function = ClassifyBlocksAvx2;
+        result.name     = "avx2";
+    }
+#endif
+    return result;
+}
+
+//=========================================================================
+const Classifier & GetClassifier () {
+    static const Classifier s_classifier = SelectClassifier();
+    return s_classifier;
+}
+
+//=========================================================================
+struct StringStopMask {
+    std::uint64_t operator() (const JsonBlockMasks & masks) const {
+        return masks.quote | masks.backslash;
+    }
+};
+
+//=========================================================================
+struct NonWhitespaceMask {
+    std::uint64_t operator() (const JsonBlockMasks & masks) const {
+        return ~masks.whitespace;
+    }
+};
+
+} // namespace
+
+//=========================================================================
+JsonStructuralIndex::JsonStructuralIndex ()
+    : m_sourceSize(0)
+    , m_denseEnd(0)
+    , m_scanning(false)
+    , m_stopScanThreads(false)
+    , m_segmentCount(0)
+    , m_nextSegment(0)
+    , m_currentSegment(0)
+    , m_scansInFlight(0)
+{
+    Attach(nullptr, 0);
+}
+
+//=========================================================================
+JsonStructuralIndex::~JsonStructuralIndex () {
+    StopScanning();
+    StopScanThreads();
+}
+
+//=========================================================================
+void JsonStructuralIndex::Attach (const char * source, std::size_t sourceSize) {
+    StopScanning();
+
+    m_denseEnd    = m_denseEnd > m_sourceSize ? m_denseEnd - m_sourceSize : 0;
+    m_source      = source;
+    m_sourceSize  = sourceSize;
+    m_windowBegin = 0;
+    m_windowEnd   = 0;
+    m_windowMasks = m_masks;
+
+    if (!m_scanThreads.empty() && sourceSize >= s_minScanSegments * s_segmentSize)
+        StartScanning();
+}
+
+//=========================================================================
+void JsonStructuralIndex::Detach () {
+    StopScanning();
+}
+
+//=========================================================================
+void JsonStructuralIndex::IndexWindowAt (std::size_t sourceIndex) {
+    // take the segment from the scan threads, waiting if it isn't done yet
+    if (m_scanning) {
+        const std::size_t segmentIndex = sourceIndex / s_segmentSize;
+
+        std::unique_lock<std::mutex> lock(m_scanMutex);
+        // Segments before this one are free to reuse.  Going back would need
+        //   one that may already have been reused; the parser never does.
+        if (segmentIndex >= m_currentSegment) {
+            m_currentSegment = segmentIndex;
+            m_scanWork.notify_all();
+
+            const Segment & segment = m_segments[segmentIndex % m_segments.size()];
+            while (segment.index != segmentIndex || !segment.ready)
+                m_segmentDone.wait(lock);
+
+            m_windowMasks = segment.masks.data();
+            m_windowBegin = segmentIndex * s_segmentSize;
+            m_windowEnd   = segment.end;
+            return;
+        }
+    }
+
+    m_windowMasks = m_masks;
+    m_windowBegin = sourceIndex - sourceIndex % s_blockSize;
+    m_windowEnd   = ClassifyRange(m_windowBegin, s_windowBlocks, m_masks);
+
+    // Only lazily classified windows are measured; scan threads' segments
+    //   cost the parser nothing to use.  The first few blocks are a good
+    //   enough sample, and counting bits isn't free.
+    std::size_t sampleBlocks = (m_windowEnd - m_windowBegin) / s_blockSize;
+    if (sampleBlocks > s_denseSampleBlocks)
+        sampleBlocks = s_denseSampleBlocks;
+    std::size_t stops = 0;
+    for (std::size_t block = 0;  block < sampleBlocks;  ++block)
+        stops += std::bitset<64>(m_masks[block].quote | m_masks[block].structural).count();
+    if (stops * s_denseSpacing >= sampleBlocks * s_blockSize)
+        m_denseEnd = m_windowEnd + s_denseStretchWindows * s_windowBlocks * s_blockSize;
+    else
+        m_denseEnd = m_windowBegin;
+}
+
+//=========================================================================
+std::size_t JsonStructuralIndex::ClassifyRange (
+    std::size_t      begin,
+    std::size_t      blockLimit,
+    JsonBlockMasks * result
+) const {
+    std::size_t wholeBlocks = (m_sourceSize - begin) / s_blockSize;
+    if (wholeBlocks > blockLimit)
+        wholeBlocks = blockLimit;
+    ClassifyBlocks(m_source + begin, wholeBlocks, result);
+    std::size_t end = begin + wholeBlocks * s_blockSize;
+
+    // the buffer's last, partial block gets padded out with (ignorable)
+    //   whitespace, rather than reading past the end of the buffer.
+    if (wholeBlocks < blockLimit && end < m_sourceSize) {
+        char lastBlock[s_blockSize];
+        memset(lastBlock, ' ', s_blockSize);
+        memcpy(lastBlock, m_source + end, m_sourceSize - end);
+        ClassifyBlocks(lastBlock, 1, result + wholeBlocks);
+        end += s_blockSize;
+    }
+
+    return end;
+}
+
+//=========================================================================
+void JsonStructuralIndex::SetScanThreads (std::size_t threadCount) {
+    StopScanning();
+    StopScanThreads();
+    if (threadCount == 0)
+        return;
+
+    // Twice as many segments as threads, so every thread has one to work on
+    //   while the parser works through the others.
+    m_segments.resize(threadCount * 2);
+    for (Segment & segment : m_segments)
+        segment.masks.resize(s_segmentBlocks);
+
+    m_stopScanThreads = false;
+    for (std::size_t i = 0;  i < threadCount;  ++i)
+        m_scanThreads.emplace_back(&JsonStructuralIndex::ScanThread, this);
+}
+
+//=========================================================================
+void JsonStructuralIndex::ScanThread () {
+    std::unique_lock<std::mutex> lock(m_scanMutex);
+    for (;;) {
+        // wait for a segment to classify, and a free place to put it
+        while (
+            !m_stopScanThreads &&
+            !(m_nextSegment < m_segmentCount && m_nextSegment < m_currentSegment + m_segments.size())
+        )
+            m_scanWork.wait(lock);
+        if (m_stopScanThreads)
+            return;
+
+        const std::size_t segmentIndex = m_nextSegment++;
+        Segment &         segment      = m_segments[segmentIndex % m_segments.size()];
+        segment.index = segmentIndex;
+        segment.ready = false;
+        ++m_scansInFlight;
+
+        lock.unlock();
+        const std::size_t end = ClassifyRange(segmentIndex * s_segmentSize, s_segmentBlocks, segment.masks.data());
+        lock.lock();
+
+        segment.end   = end;
+        segment.ready = true;
+        --m_scansInFlight;
+        m_segmentDone.notify_all();
+    }
+}
+
+//=========================================================================
+void JsonStructuralIndex::StartScanning () {
+    {
+        std::lock_guard<std::mutex> lock(m_scanMutex);
+        for (Segment & segment : m_segments) {
+            segment.index = std::size_t(-1);
+            segment.ready = false;
+        }
+        m_segmentCount   = (m_sourceSize + s_segmentSize - 1) / s_segmentSize;
+        m_nextSegment    = 0;
+        m_currentSegment = 0;
+        m_scanning       = true;
+    }
+    m_scanWork.notify_all();
+}
+
+//=========================================================================
+void JsonStructuralIndex::StopScanning () {
+    if (!m_scanning)
+        return;
+
+    // no new segments, and wait out the ones being classified; the buffer
+    //   may be gone once this returns.
+    std::unique_lock<std::mutex> lock(m_scanMutex);
+    m_segmentCount = 0;
+    m_scanning     = false;
+    while (m_scansInFlight)
+        m_segmentDone.wait(lock);
+}
+
+//=========================================================================
+void JsonStructuralIndex::StopScanThreads () {
+    {
+        std::lock_guard<std::mutex> lock(m_scanMutex);
+        m_stopScanThreads = true;
+    }
+    m_scanWork.notify_all();
+    for (std::thread & thread : m_scanThreads)
+        thread.join();
+    m_scanThreads.clear();
+}
+
+//=========================================================================
+template <typename MaskSelector>
+std::size_t JsonStructuralIndex::FindNext (std::size_t from, MaskSelector selector) {
+    while (from < m_sourceSize) {
+        if (from < m_windowBegin || from >= m_windowEnd)
+            IndexWindowAt(from);
+
+        const std::size_t blockCount = (m_windowEnd - m_windowBegin) / s_blockSize;
+        std::size_t       block      = (from - m_windowBegin) / s_blockSize;
+        // ignore anything before `from` in its block
+        std::uint64_t     bits       = selector(m_windowMasks[block]) & (~std::uint64_t(0) << (from % s_blockSize));
+        for (;;) {
+            if (bits) {
+                const std::size_t found = m_windowBegin + block * s_blockSize + CountTrailingZeros(bits);
+                return found < m_sourceSize ? found : m_sourceSize;
+            }
+            if (++block >= blockCount)
+                break;
+            bits = selector(m_windowMasks[block]);
+        }
+
+        from = m_windowEnd;
+    }
+
+    return m_sourceSize;
+}
+
+//=========================================================================
+std::size_t JsonStructuralIndex::FindStringStop (std::size_t from) {
+    return FindNext(from, StringStopMask());
+}
+
+//=========================================================================
+std::size_t JsonStructuralIndex::FindNonWhitespace (std::size_t from) {
+    return FindNext(from, NonWhitespaceMask());
+}
+
+//=========================================================================
+void JsonStructuralIndex::ClassifyBlocks (const char * data, std::size_t blockCount, JsonBlockMasks * result) {
+    GetClassifier().function(data, blockCount, result);
+}
+
+//=========================================================================
+const char * JsonStructuralIndex::GetClassifierName () {
+    return GetClassifier().name;
+}
+
+//=========================================================================
+void JsonStructuralIndex::FindContainerSizes (
+    const char *                     source,
+    std::size_t                      sourceSize,
+    std::vector<JsonContainerSize> * sizes
+) {
+    const std::uint64_t evenBits = 0x5555555555555555ULL;
+
+    // entries in sizes still open; their size holds the commas seen so far
+    std::vector<std::size_t> open;
+    // carried from one block to the next
+    std::uint64_t prevEndsOddBackslash = 0;
+    std::uint64_t prevInString         = 0;
+
+    JsonBlockMasks masks[s_windowBlocks];
+    for (std::size_t begin = 0;  begin < sourceSize;  begin += s_windowBlocks * s_blockSize) {
+        // classify a window, padding the last partial block with whitespace
+        std::size_t wholeBlocks = (sourceSize - begin) / s_blockSize;
+        if (wholeBlocks > s_windowBlocks)
+            wholeBlocks = s_windowBlocks;
+        ClassifyBlocks(source + begin, wholeBlocks, masks);
+        std::size_t blockCount = wholeBlocks;
+        const std::size_t end  = begin + wholeBlocks * s_blockSize;
+        if (wholeBlocks < s_windowBlocks && end < sourceSize) {
+            char lastBlock[s_blockSize];
+            memset(lastBlock, ' ', s_blockSize);
+            memcpy(lastBlock, source + end, sourceSize - end);
+            ClassifyBlocks(lastBlock, 1, masks + wholeBlocks);
+            ++blockCount;
+        }
+
+        for (std::size_t block = 0;  block < blockCount;  ++block) {
+            // Quotes preceded by an odd run of backslashes are escaped.  Runs
+            //   are found by adding each run's start to the backslash bits,
+            //   which carries to just past its end; the run is odd if it
+            //   started and ended on bits of different parity.
+            const std::uint64_t backslash     = masks[block].backslash;
+            const std::uint64_t startEdges    = backslash & ~(backslash << 1);
+            const std::uint64_t evenStartMask = evenBits ^ prevEndsOddBackslash;
+            const std::uint64_t evenStarts    = startEdges & evenStartMask;
+            const std::uint64_t oddStarts     = startEdges & ~evenStartMask;
+            const std::uint64_t evenCarries   = backslash + evenStarts;
+            std::uint64_t       oddCarries    = backslash + oddStarts;
+            const bool          endsOdd       = oddCarries < backslash;
+            oddCarries          |= prevEndsOddBackslash;
+            prevEndsOddBackslash = endsOdd ? 1 : 0;
+            const std::uint64_t oddEnds =
+                ((evenCarries & ~backslash) & ~evenBits) |
+                ((oddCarries  & ~backslash) &  evenBits);
+
+            // each unescaped quote toggles being in a string: a prefix xor
+            std::uint64_t inString = masks[block].quote & ~oddEnds;
+            inString ^= inString << 1;
+            inString ^= inString << 2;
+            inString ^= inString << 4;
+            inString ^= inString << 8;
+            inString ^= inString << 16;
+            inString ^= inString << 32;
+            inString ^= prevInString;
+            prevInString = (inString >> 63) ? ~std::uint64_t(0) : 0;
+
+            const std::size_t blockBegin = begin + block * s_blockSize;
+            std::uint64_t     structural = masks[block].structural & ~inString;
+            while (structural) {
+                const std::size_t index = blockBegin + CountTrailingZeros(structural);
+                structural &= structural - 1;
+                if (index >= sourceSize)
+                    break;
+
+                switch (source[index]) {
+                    case '{':
+                    case '[': {
+                        open.push_back(sizes->size());
+                        JsonContainerSize container = { index, 0 };
+                        sizes->push_back(container);
+                    } break;
+
+                    case ',': {
+                        if (!open.empty())
+                            ++(*sizes)[open.back()].size;
+                    } break;
+
+                    case '}':
+                    case ']': {
+                        if (open.empty())
+                            return;
+                        JsonContainerSize & container = (*sizes)[open.back()];
+                        open.pop_back();
+                        if (container.size > 0)
+                            ++container.size;
+                        else {
+                            // one element, unless nothing but whitespace
+                            //   lies between the brackets
+                            std::size_t next = container.offset + 1;
+                            while (
+                                next < index &&
+                                s_charClassTable.classes[static_cast<unsigned char>(source[next])] == CharClass_Whitespace
+                            )
+                                ++next;
+                            container.size = (next < index) ? 1 : 0;
+                        }
+                    } break;
+
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+
+    for (std::size_t index : open)
+        (*sizes)[index].size = s_unknownSize;
+}
+
+} // namespace CSaruJson
@@ -0,0 +1,402 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring> // strlen()
+
+#include "exported/JsonWriter.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+JsonWriter::JsonWriter (JsonOutput * output, const JsonFormat & format)
+    : m_output(output)
+    , m_format(format)
+    , m_first(true)
+    , m_afterKey(false)
+    , m_rootWritten(false)
+    , m_errorStatus(ErrorStatus::None)
+    , m_skippedDocuments(0)
+{}
+
+//=========================================================================
+void JsonWriter::Reset () {
+    m_containers.clear();
+    m_first       = true;
+    m_afterKey    = false;
+    m_rootWritten = false;
+    m_errorStatus = ErrorStatus::None;
+}
+
+//=========================================================================
+// Line break and indent, unless compact.
+void JsonWriter::WriteLine (std::size_t depth) {
+    if (m_format.compact)
+        return;
+
+    m_output->Put('\n');
+    if (m_format.indentWidth > 0)
+        m_output->WriteRepeated(m_format.indentChar, depth * std::size_t(m_format.indentWidth));
+}
+
+//=========================================================================
+// What goes before each element of a container: the separator from the
+//   previous one, then its own line.
+void JsonWriter::BeginElement () {
+    if (!m_first)
+        m_output->Put(',');
+    m_first = false;
+    WriteLine(m_containers.size());
+}
+
+//=========================================================================
+// RETURN: false if a value can't go here; the error has been recorded.
+bool JsonWriter::BeginValue () {
+    if (m_errorStatus != ErrorStatus::None)
+        return false;
+
+    if (m_containers.empty()) {
+        if (m_rootWritten) {
+            m_errorStatus = ErrorStatus::Error_SecondRoot;
+            return false;
+        }
+        m_rootWritten = true;
+    }
+    else if (m_containers.back()) {
+        // the key wrote the element's separator and line
+        if (!m_afterKey) {
+            m_errorStatus = ErrorStatus::Error_ExpectedKey;
+            return false;
+        }
+        m_afterKey = false;
+    }
+    else {
+        BeginElement();
+    }
+    return true;
+}
+
+//=========================================================================
+void JsonWriter::EndValue () {
+    // end the document's last line, as JsonGenerator does
+    if (m_containers.empty() && !m_format.compact)
+        m_output->Put('\n');
+}
+
+//=========================================================================
+void JsonWriter::BeginContainer (bool isObject) {
+    if (!BeginValue())
+        return;
+
+    m_output->Put(isObject ? '{' : '[');
+    m_containers.push_back(isObject);
+    m_first = true;
+}
+
+//=========================================================================
+void JsonWriter::EndContainer (bool isObject) {
+    if (m_errorStatus != ErrorStatus::None)
+        return;
+    if (m_containers.empty() || m_containers.back() != isObject || m_afterKey) {
+        m_errorStatus = ErrorStatus::Error_MismatchedEnd;
+        return;
+    }
+
+    m_containers.pop_back();
+    // even an empty container closes on a line of its own, as JsonGenerator
+    //   writes them
+    WriteLine(m_containers.size());
+    m_output->Put(isObject ? '}' : ']');
+    // the container was an element of its parent
+    m_first = false;
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::BeginObject () {
+    BeginContainer(true);
+}
+
+//=========================================================================
+void JsonWriter::EndObject () {
+    EndContainer(true);
+}
+
+//=========================================================================
+void JsonWriter::BeginArray () {
+    BeginContainer(false);
+}
+
+//=========================================================================
+void JsonWriter::EndArray () {
+    EndContainer(false);
+}
+
+//=========================================================================
+void JsonWriter::Key (const char * name, std::size_t nameLen) {
+    if (m_errorStatus != ErrorStatus::None)
+        return;
+    if (m_containers.empty() || !m_containers.back() || m_afterKey) {
+        m_errorStatus = ErrorStatus::Error_KeyNotInObject;
+        return;
+    }
+
+    BeginElement();
+    m_output->Put('"');
+    m_output->WriteEscaped(name, nameLen);
+    if (m_format.compact)
+        m_output->Write("\":", 2);
+    else
+        m_output->Write("\": ", 3);
+    m_afterKey = true;
+}
+
+//=========================================================================
+void JsonWriter::Key (const char * name) {
+    Key(name, strlen(name));
+}
+
+//=========================================================================
+void JsonWriter::String (const char * value, std::size_t valueLen) {
+    if (!BeginValue())
+        return;
+
+    m_output->Put('"');
+    m_output->WriteEscaped(value, valueLen);
+    m_output->Put('"');
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::String (const char * value) {
+    String(value, strlen(value));
+}
+
+//=========================================================================
+void JsonWriter::Int (std::int64_t value) {
+    if (!BeginValue())
+        return;
+
+    m_output->WriteInt64(value);
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::UInt (std::uint64_t value) {
+    if (!BeginValue())
+        return;
+
+    m_output->WriteUInt64(value);
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::Double (double value) {
+    if (!BeginValue())
+        return;
+
+    m_output->WriteDouble(value);
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::Float (float value) {
+    if (!BeginValue())
+        return;
+
+    m_output->WriteFloat(value);
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::Bool (bool value) {
+    if (!BeginValue())
+        return;
+
+    if (value)
+        m_output->Write("true", 4);
+    else
+        m_output->Write("false", 5);
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::Null () {
+    if (!BeginValue())
+        return;
+
+    m_output->Write("null", 4);
+    EndValue();
+}
+
+//=========================================================================
+std::size_t JsonWriter::GetSkippedDocuments () const {
+    return m_skippedDocuments;
+}
+
+//=========================================================================
+bool JsonWriter::IsComplete () const {
+    return m_rootWritten && m_containers.empty() && GetErrorStatus() == ErrorStatus::None;
+}
+
+//=========================================================================
+JsonWriter::ErrorStatus JsonWriter::GetErrorStatus () const {
+    if (m_errorStatus == ErrorStatus::None && m_output->HadError())
+        return ErrorStatus::Error_OutputFailed;
+    return m_errorStatus;
+}
+
+//=========================================================================
+// CallbackInterface implementations
+//=========================================================================
+
+//=========================================================================
+void JsonWriter::KeyIfInObject (const char * name, std::size_t nameLen) {
+    if (!m_containers.empty() && m_containers.back())
+        Key(name, nameLen);
+}
+
+//=========================================================================
+void JsonWriter::BeginObject (const char * name, std::size_t nameLen) {
+    KeyIfInObject(name, nameLen);
+    BeginObject();
+}
+
+//=========================================================================
+void JsonWriter::BeginArray (const char * name, std::size_t nameLen) {
+    KeyIfInObject(name, nameLen);
+    BeginArray();
+}
+
+//=========================================================================
+void JsonWriter::GotString (const char * name, std::size_t nameLen, const char * value, std::size_t valueLen) {
+    KeyIfInObject(name, nameLen);
+    String(value, valueLen);
+}
+
+//=========================================================================
+void JsonWriter::GotFloat (const char * name, std::size_t nameLen, float value) {
+    KeyIfInObject(name, nameLen);
+    Float(value);
+}
+
+//=========================================================================
+void JsonWriter::GotInteger (const char * name, std::size_t nameLen, int value) {
+    KeyIfInObject(name, nameLen);
+    Int(value);
+}
+
+//=========================================================================
+void JsonWriter::GotBoolean (const char * name, std::size_t nameLen, bool value) {
+    KeyIfInObject(name, nameLen);
+    Bool(value);
+}
+
+//=========================================================================
+void JsonWriter::GotNull (const char * name, std::size_t nameLen) {
+    KeyIfInObject(name, nameLen);
+    Null();
+}
+
+//=========================================================================
+void JsonWriter::GotInt64 (const char * name, std::size_t nameLen, std::int64_t value) {
+    KeyIfInObject(name, nameLen);
+    Int(value);
+}
+
+//=========================================================================
+void JsonWriter::GotUInt64 (const char * name, std::size_t nameLen, std::uint64_t value) {
+    KeyIfInObject(name, nameLen);
+    UInt(value);
+}
+
+//=========================================================================
+void JsonWriter::GotDouble (const char * name, std::size_t nameLen, double value) {
+    KeyIfInObject(name, nameLen);
+    Double(value);
+}
+
+//=========================================================================
+void JsonWriter::GotNumberRaw (
+    const char *               name,
+    std::size_t                nameLen,
+    const char *               text,
+    std::size_t                textLen,
+    JsonParserBase::NumberKind /*kind*/
+) {
+    KeyIfInObject(name, nameLen);
+    // the parser has validated it
+    if (!BeginValue())
+        return;
+
+    m_output->Write(text, textLen);
+    EndValue();
+}
+
+//=========================================================================
+void JsonWriter::GotStringSpan (
+    const char * name,
+    std::size_t  nameLen,
+    const char * value,
+    std::size_t  valueLen,
+    bool         valueHasEscapes
+) {
+    if (!valueHasEscapes) {
+        GotString(name, nameLen, value, valueLen);
+        return;
+    }
+
+    // escapes are resolved and then redone, so they come out the same way
+    //   as everything else the writer escapes
+    if (m_unescaped.size() < valueLen)
+        m_unescaped.resize(valueLen);
+    const std::size_t length = JsonParserBase::Unescape(value, valueLen, m_unescaped.data());
+    GotString(name, nameLen, m_unescaped.data(), length);
+}
+
+//=========================================================================
+void JsonWriter::EndDocument () {
+    // JSON Lines, when compact; pretty output already ended the line
+    if (m_format.compact && m_errorStatus == ErrorStatus::None)
+        m_output->Put('\n');
+    m_rootWritten = false;
+}
+
+//=========================================================================
+void JsonWriter::SkippedDocument (
+    JsonParserBase::ErrorStatus /*error*/,
+    std::size_t                 /*row*/,
+    std::size_t                 /*column*/
+) {
+    ++m_skippedDocuments;
+    if (m_errorStatus != ErrorStatus::None)
+        return;
+
+    // What's been written can't be unwritten, so end its line and leave
+    //   the containers it opened behind, rather than write the next
+    //   document into them.
+    if (m_rootWritten)
+        m_output->Put('\n');
+    m_containers.clear();
+    m_first       = true;
+    m_afterKey    = false;
+    m_rootWritten = false;
+}
+
+} // namespace CSaruJson
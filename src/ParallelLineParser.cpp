@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <cstring> // memchr()
+
+#include "exported/ParallelLineParser.hpp"
+
+namespace CSaruJson {
+
+//=========================================================================
+ParallelLineParserBase::ParallelLineParserBase ()
+    : m_chunkSize(s_defaultChunkSize)
+    , m_order(Order::Unordered)
+    , m_skipBadDocuments(false)
+    , m_structuralIndexing(false)
+    , m_zeroCopy(false)
+    , m_deferNumbers(false)
+    , m_failed(false)
+    , m_nextToCommit(0)
+    , m_errorChunk(0)
+    , m_errorStatus(JsonParserBase::ErrorStatus::NotStarted)
+{}
+
+//=========================================================================
+void ParallelLineParserBase::Prepare (const char * buffer, std::size_t bufferSize, std::size_t workerCount) {
+    m_chunks.clear();
+    for (std::size_t begin = 0;  begin < bufferSize;  ) {
+        // end just after the first newline at or past the chunk size
+        std::size_t end = bufferSize;
+        if (bufferSize - begin > m_chunkSize) {
+            const std::size_t searchFrom = begin + m_chunkSize - 1;
+            const void *      newline    = std::memchr(buffer + searchFrom, '\n', bufferSize - searchFrom);
+            if (newline)
+                end = static_cast<const char *>(newline) - buffer + 1;
+        }
+
+        Chunk chunk = { buffer + begin, end - begin };
+        m_chunks.push_back(chunk);
+        begin = end;
+    }
+
+    // Dealt out in turn, so every worker starts near the front of the data;
+    //   in Ordered mode that keeps waiting for turns short.
+    while (m_queues.size() < workerCount)
+        m_queues.emplace_back(new WorkQueue());
+    for (std::size_t worker = 0;  worker < m_queues.size();  ++worker)
+        m_queues[worker]->chunks.clear();
+    for (std::size_t chunkIndex = 0;  chunkIndex < m_chunks.size();  ++chunkIndex)
+        m_queues[chunkIndex % workerCount]->chunks.push_back(chunkIndex);
+
+    m_failed       = false;
+    m_nextToCommit = 0;
+    m_errorChunk   = 0;
+    m_errorStatus  = JsonParserBase::ErrorStatus::Done;
+}
+
+//=========================================================================
+bool ParallelLineParserBase::TakeChunk (std::size_t worker, std::size_t * chunkIndex) {
+    // Always the lowest-numbered chunk of a queue, own or someone else's.
+    //   In Ordered mode this means every chunk before one being worked on is
+    //   taken too, so a worker waiting for its turn always gets it.
+    const std::size_t queueCount = m_queues.size();
+    for (std::size_t i = 0;  i < queueCount && !m_failed;  ++i) {
+        WorkQueue & queue = *m_queues[(worker + i) % queueCount];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.chunks.empty()) {
+            *chunkIndex = queue.chunks.front();
+            queue.chunks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//=========================================================================
+bool ParallelLineParserBase::WaitForTurn (std::size_t chunkIndex) {
+    if (m_order == Order::Unordered)
+        return !m_failed;
+
+    std::unique_lock<std::mutex> lock(m_commitMutex);
+    while (m_nextToCommit != chunkIndex && !m_failed)
+        m_committed.wait(lock);
+    return !m_failed;
+}
+
+//=========================================================================
+void ParallelLineParserBase::EndTurn (std::size_t chunkIndex) {
+    if (m_order == Order::Unordered)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        m_nextToCommit = chunkIndex + 1;
+    }
+    m_committed.notify_all();
+}
+
+//=========================================================================
+void ParallelLineParserBase::Fail (std::size_t chunkIndex, JsonParserBase::ErrorStatus status) {
+    {
+        std::lock_guard<std::mutex> lock(m_commitMutex);
+        if (!m_failed || chunkIndex < m_errorChunk) {
+            m_errorChunk  = chunkIndex;
+            m_errorStatus = status;
+        }
+        m_failed = true;
+    }
+    m_committed.notify_all();
+}
+
+//=========================================================================
+void ParallelLineParserBase::SetChunkSize (std::size_t chunkSize) {
+    m_chunkSize = chunkSize ? chunkSize : 1;
+}
+
+//=========================================================================
+void ParallelLineParserBase::SetOrder (Order order) {
+    m_order = order;
+}
+
+//=========================================================================
+void ParallelLineParserBase::SetSkipBadDocuments (bool enabled) {
+    m_skipBadDocuments = enabled;
+}
+
+//=========================================================================
+void ParallelLineParserBase::SetStructuralIndexing (bool enabled) {
+    m_structuralIndexing = enabled;
+}
+
+//=========================================================================
+void ParallelLineParserBase::SetZeroCopy (bool enabled) {
+    m_zeroCopy = enabled;
+}
+
+//=========================================================================
+void ParallelLineParserBase::SetDeferredNumbers (bool enabled) {
+    m_deferNumbers = enabled;
+}
+
+//=========================================================================
+std::size_t ParallelLineParserBase::DefaultWorkerCount () {
+    const std::size_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+} // namespace CSaruJson
@@ -0,0 +1,2753 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <algorithm> // min()
+#include <cstdint>
+#include <cstdio>
+#include <cstring> // memcpy()
+#include <limits>
+#include <vector>
+
+#include "JsonBitStack.hpp"
+#include "JsonMappedFile.hpp"
+#include "JsonNumbers.hpp"
+#include "JsonReadAhead.hpp"
+#include "JsonScratchBuffer.hpp"
+#include "JsonStructuralIndex.hpp"
+
+namespace CSaruJson {
+
+// Everything about the parser that doesn't depend on who receives its events.
+class JsonParserBase {
+public:
+    // Types and Constants
+    // Starting sizes of the name/data scratch buffers.  Longer names and
+    //   strings grow their buffer instead of being truncated.
+    static const std::size_t s_initialNameCapacity = 32;
+    static const std::size_t s_initialStringCapacity = 256;
+    // Buffers smaller than this are parsed byte-by-byte even when structural
+    //   indexing is on.
+    static const std::size_t s_minIndexedBufferSize = 256;
+    // Strings are scanned byte-by-byte for this long before using the index.
+    static const std::size_t s_shortStringScan = 16;
+    // Deepest nesting accepted unless SetMaxDepth() says otherwise.
+    static const std::size_t s_defaultMaxDepth = 512;
+    // Most input kept around an error, in ParseError::context.
+    static const std::size_t s_errorContextSize = 32;
+
+    enum class ErrorStatus {
+        NotStarted = 0,
+        NotFinished,
+        Done,
+
+        // lowest actual error code.  If checking for error, check if status is
+        //   greater-than-or-equal-to this code.
+        Error_Unspecified,
+
+        // No data buffer given, or no file given, or no DataMapMutator given.
+        Error_CantAccessData,
+
+        // Failed to read from the given file.
+        Error_BadFileRead,
+
+        // lowest parsing-based error.  This and above means your data is
+        //   malformed.
+        ParseError_Unspecified,
+
+        ParseError_ExpectedBeginObject,
+        ParseError_ExpectedEndOfObject,
+        ParseError_ExpectedEndOfArray,
+        ParseError_ExpectedString,
+        ParseError_SixCharacterEscapeSequenceNotYetSupported,
+        ParseError_InvalidEscapedCharacter,
+        ParseError_ExpectedNameValueSeparator,
+        ParseError_ExpectedValue,
+        ParserError_PrematureDecimalPoint,
+        ParserError_UnfinishedFractionalNumber,
+        ParseError_ExpectedDigit,
+        ParseError_ExpectedDecimalOrEndOfNumber,
+        ParseError_ExpectedDigitOrDecimalOrEndOfNumber,
+        ParseError_ExpectedDigitOrEndOfNumber,
+        ParseError_ExpectedContinuationOfTrueKeyword,
+        ParseError_ExpectedContinuationOfFalseKeyword,
+        ParseError_ExpectedContinuationOfNullKeyword,
+        ParseError_BadValue, // such as "nulll"
+        ParseError_ExpectedValueSeparatorOrEndOfContainer,
+        ParseError_BadStructure,
+        ParseError_UnfinishedExponent,
+        ParseError_UnexpectedEndOfData,
+        ParseError_MaxDepthExceeded
+    };
+
+    enum class ParserStatus {
+        NotStarted = 0,
+
+        BeganObject,
+        BeganArray,
+        ReadingName,
+        ReadingName_EscapedChar,
+        FinishedName,
+        SawNameValueSeparator,
+
+        ReadingStringValue,
+        ReadingStringValue_EscapedChar,
+
+        NumberSawLeadingNegativeSign,
+        NumberSawLeadingZero,
+        NumberReadingWholeDigits,
+        NumberSawDecimalPoint,
+        NumberReadingFractionalDigits,
+        NumberSawExponentMarker,
+        NumberSawExponentSign,
+        NumberReadingExponentDigits,
+
+        ReadingTrueValue,
+        ReadingFalseValue,
+        ReadingNullValue,
+
+        FinishedValue,
+        NeedAnotherDataElement_InObject,
+        NeedAnotherDataElement_InArray,
+
+        SkippingContainer,
+        // multiple documents: dropping the rest of a malformed line
+        SkippingToNewline,
+
+        Done,
+        FinishedAllData
+    };
+
+    // How a number was written, for CallbackInterface::GotNumberRaw().
+    enum class NumberKind {
+        Integer, // digits only, maybe with a leading '-'
+        Real     // has a fraction, an exponent, or both
+    };
+
+    struct CallbackInterface {
+        virtual ~CallbackInterface () {}
+
+        virtual void BeginObject (const char * name, std::size_t name_len) = 0;
+        virtual void EndObject () = 0;
+        virtual void BeginArray (const char * name, std::size_t name_len) = 0;
+        virtual void EndArray () = 0;
+        virtual void GotString (const char * name, std::size_t name_len, const char * value, std::size_t value_len) = 0;
+        virtual void GotFloat (const char * name, std::size_t name_len, float value) = 0;
+        virtual void GotInteger (const char * name, std::size_t name_len, int value) = 0;
+        virtual void GotBoolean (const char * name, std::size_t name_len, bool value) = 0;
+        virtual void GotNull (const char * name, std::size_t name_len) = 0;
+
+        // Numbers are delivered through the narrowest of GotInteger(),
+        //   GotInt64() and GotUInt64() that holds them exactly, and through
+        //   GotDouble() if they have a fraction or exponent, or don't fit 64
+        //   bits.  By default each of these forwards to the next wider type,
+        //   ending at GotFloat(), so overriding only GotInteger() and
+        //   GotFloat() still sees every number.
+        virtual void GotInt64 (const char * name, std::size_t name_len, std::int64_t value) {
+            GotDouble(name, name_len, static_cast<double>(value));
+        }
+        virtual void GotUInt64 (const char * name, std::size_t name_len, std::uint64_t value) {
+            GotDouble(name, name_len, static_cast<double>(value));
+        }
+        virtual void GotDouble (const char * name, std::size_t name_len, double value) {
+            GotFloat(name, name_len, static_cast<float>(value));
+        }
+
+        // Only called with deferred numbers on (see SetDeferredNumbers()), in
+        //   place of all the number callbacks above.  text is the number
+        //   exactly as written, already validated.  It is not NUL-terminated
+        //   and is only valid for the duration of this call; JsonNumbers can
+        //   convert it.  By default, converts it and calls the number callback
+        //   it would have gone to.
+        virtual void GotNumberRaw (
+            const char * name,
+            std::size_t  name_len,
+            const char * text,
+            std::size_t  text_len,
+            NumberKind   kind
+        );
+
+        // Only called in zero-copy mode (see SetZeroCopy()), in place of
+        //   GotString().  value may point straight into the buffer given to
+        //   ParseBuffer(); it is not NUL-terminated and is only valid for the
+        //   duration of this call.  If value_has_escapes, value still holds
+        //   raw backslash escape sequences (see Unescape()).
+        virtual void GotStringSpan (
+            const char * name,
+            std::size_t  name_len,
+            const char * value,
+            std::size_t  value_len,
+            bool         value_has_escapes
+        ) {
+            (void)value_has_escapes;
+            GotString(name, name_len, value, value_len);
+        }
+
+        // Only called with container sizes on (see SetContainerSizes()), in
+        //   place of BeginObject()/BeginArray() when the number of members or
+        //   elements is already known.  size is exact; what follows is
+        //   delivered as usual.
+        virtual void BeginObjectSized (const char * name, std::size_t name_len, std::size_t size) {
+            (void)size;
+            BeginObject(name, name_len);
+        }
+        virtual void BeginArraySized (const char * name, std::size_t name_len, std::size_t size) {
+            (void)size;
+            BeginArray(name, name_len);
+        }
+
+        // Only called with multiple documents on (see SetMultipleDocuments()).
+        //   A root object just closed; another may follow.
+        virtual void EndDocument () {}
+        // Only called when skipping bad documents.  The document being read
+        //   was malformed (error, at row and column) and the rest of its line
+        //   is being dropped.  Events already delivered for it stand.
+        virtual void SkippedDocument (ErrorStatus error, std::size_t row, std::size_t column) {
+            (void)error;
+            (void)row;
+            (void)column;
+        }
+    };
+
+    // What went wrong, and where.  Filled in as the error is found; nothing
+    //   is formatted or printed unless asked for (see SetPrintErrors()).
+    struct ParseError {
+        ErrorStatus  code;
+        // absolute byte offset of the error (see GetByteOffset())
+        std::size_t  offset;
+        // static description, never null
+        const char * message;
+        // up to s_errorContextSize bytes of the input around the error, as
+        //   they were, NUL-terminated.  The error is at context[contextIndex]
+        //   (the terminator, if it was at the end of a buffer).  Empty if the
+        //   input wasn't at hand, such as at the end of the data.
+        char         context[s_errorContextSize + 1];
+        std::size_t  contextIndex;
+    };
+
+    // Receives each error as it's found: just before the parse stops, or
+    //   before the document is skipped when skipping bad documents.  The
+    //   parser's GetPosition() gives its row and column during the call.
+    class ErrorSink {
+    public:
+        virtual ~ErrorSink () {}
+        virtual void GotError (const ParseError & error) = 0;
+    };
+
+    // Resolves the escape sequences in a raw string value.  dest needs room
+    //   for sourceLen chars, and may be the same as source.
+    // RETURN: Length of the unescaped string written to dest.
+    static std::size_t Unescape (const char * source, std::size_t sourceLen, char * dest);
+
+    // Hand a finished number to handler, through the narrowest of its number
+    //   callbacks that holds it.  For handlers' GotNumberRaw().
+    template <typename Handler>
+    static void DeliverNumber (
+        Handler *           handler,
+        const char *        name,
+        std::size_t         nameLen,
+        const JsonDecimal & number,
+        const char *        text,
+        std::size_t         textLen,
+        NumberKind          kind
+    );
+
+protected:
+    // Translates the character following a backslash.  Returns false for
+    //   anything that isn't a (supported) escape sequence.
+    static bool TranslateEscapedCharacter (char escapeCode, char * result);
+
+    static void PrintError (std::size_t row, std::size_t column, const char * message);
+    // Description of an error that was found without one of its own.
+    static const char * StatusMessage (ErrorStatus status);
+
+    // Size of the read buffer ParseEntireFile() makes if it isn't given one.
+    static std::size_t DefaultReadBufferSize ();
+};
+
+// Default implementations of a handler's optional events, for use with
+//   BasicJsonParser directly:
+//
+//   struct Counter : JsonHandlerBase<Counter> { ... };
+//
+// The handler must still provide BeginObject(), EndObject(), BeginArray(),
+//   EndArray(), GotString(), GotFloat(), GotInteger(), GotBoolean() and
+//   GotNull(), with the same signatures as in CallbackInterface (minus the
+//   virtual).  The defaults here forward the same way CallbackInterface's do.
+template <typename Derived>
+struct JsonHandlerBase {
+    inline void GotInt64 (const char * name, std::size_t name_len, std::int64_t value) {
+        Self()->GotDouble(name, name_len, static_cast<double>(value));
+    }
+    inline void GotUInt64 (const char * name, std::size_t name_len, std::uint64_t value) {
+        Self()->GotDouble(name, name_len, static_cast<double>(value));
+    }
+    inline void GotDouble (const char * name, std::size_t name_len, double value) {
+        Self()->GotFloat(name, name_len, static_cast<float>(value));
+    }
+
+    inline void GotNumberRaw (
+        const char *               name,
+        std::size_t                name_len,
+        const char *               text,
+        std::size_t                text_len,
+        JsonParserBase::NumberKind kind
+    ) {
+        // the parser already validated text
+        JsonDecimal number;
+        JsonNumbers::Scan(text, text_len, &number);
+        JsonParserBase::DeliverNumber(Self(), name, name_len, number, text, text_len, kind);
+    }
+
+    inline void GotStringSpan (
+        const char * name,
+        std::size_t  name_len,
+        const char * value,
+        std::size_t  value_len,
+        bool         value_has_escapes
+    ) {
+        (void)value_has_escapes;
+        Self()->GotString(name, name_len, value, value_len);
+    }
+
+    inline void BeginObjectSized (const char * name, std::size_t name_len, std::size_t) {
+        Self()->BeginObject(name, name_len);
+    }
+    inline void BeginArraySized (const char * name, std::size_t name_len, std::size_t) {
+        Self()->BeginArray(name, name_len);
+    }
+
+    inline void EndDocument () {}
+    inline void SkippedDocument (JsonParserBase::ErrorStatus, std::size_t, std::size_t) {}
+
+private:
+    inline Derived * Self () { return static_cast<Derived *>(this); }
+};
+
+// The parser's state machine, calling Handler's event functions directly so
+//   they can be inlined.  Handler is usually JsonParserBase::CallbackInterface
+//   (see JsonParser), or a type derived from JsonHandlerBase.
+template <typename Handler>
+class BasicJsonParser : public JsonParserBase {
+private:
+    // Data
+    // all just for reading in from a file.  Owned by the parser and reused
+    //   across tokens and Reset()s.
+    JsonScratchBuffer m_tempName;
+    JsonScratchBuffer m_tempData;
+    // always points at one-past-the-last element
+    std::size_t m_tempNameIndex;
+    std::size_t m_tempDataIndex;
+    // the number being read.  Its text is in the caller's buffer from
+    //   m_numberSpan up to m_sourceIndex, or in m_tempData once it has crossed
+    //   a buffer boundary (m_numberSpan is null then).  Its value is
+    //   accumulated in m_number, unless numbers are deferred.
+    JsonDecimal  m_number;
+    const char * m_numberSpan;
+    bool         m_deferNumbers;
+
+    // zero-copy mode: when non-null, the current name lives in the caller's
+    //   buffer instead of m_tempName (m_tempNameIndex is still its length).
+    const char * m_nameSpan;
+    bool         m_zeroCopy;
+    bool         m_keepRawEscapes;
+
+    // Pause() was called during the current event
+    bool m_pauseRequested;
+    // stopped by Pause() with input left in the current buffer
+    bool m_paused;
+
+    // SkipContainer() progress: brackets opened inside the skipped container,
+    //   and whether we're in a string (just after a backslash).
+    std::size_t m_skipDepth;
+    bool        m_skipInString;
+    bool        m_skipEscaped;
+
+    // Optional first stage; null unless SetStructuralIndexing(true).
+    JsonStructuralIndex * m_structuralIndex;
+    // The index is used from here on in the current buffer, once past any
+    //   dense stretch; std::size_t(-1) when the buffer isn't indexed.  Kept
+    //   here so testing it costs no more than testing a flag.
+    std::size_t           m_indexFrom;
+
+    // ParseEntireFile() reads ahead on another thread when the count is 2 or
+    //   more.  A size of 0 means the size of the buffer it's given.
+    std::size_t m_readAheadBufferCount;
+    std::size_t m_readAheadBufferSize;
+
+    // Container sizes from the pre-pass over the current buffer, in order of
+    //   their opening brackets; m_nextContainerSize is the next one not yet
+    //   reached.  Empty unless SetContainerSizes(true).
+    bool                           m_findContainerSizes;
+    std::vector<JsonContainerSize> m_containerSizes;
+    std::size_t                    m_nextContainerSize;
+
+    // holds true for objects, false for arrays.  Needed to keep proper track
+    //   of what data has names, and what doesn't.
+    JsonBitStack m_objectTypeStack;
+    // containers may nest no deeper than this (see SetMaxDepth()).
+    std::size_t  m_maxDepth;
+
+    ErrorStatus  m_errorStatus;
+    ParserStatus m_parserStatus;
+
+    Handler * m_dataCallback;
+
+    // Position.  Only the byte offset is kept up as parsing goes; rows and
+    //   columns are worked out from it when asked for (see CountLines()).
+    //   m_bufferOffset is the offset of m_source[0] in the whole data.
+    //   Newlines before m_countedIndex in this buffer have been counted:
+    //   m_countedRows of them, the last ending just before m_lineStart.
+    std::size_t m_bufferOffset;
+    std::size_t m_countedIndex;
+    std::size_t m_countedRows;
+    std::size_t m_lineStart;
+
+    // the last error, and who else hears about it
+    ParseError  m_error;
+    ErrorSink * m_errorSink;
+    bool        m_printErrors;
+
+    // multiple documents (see SetMultipleDocuments()).  m_documentOffset is
+    //   where the current one began.
+    bool        m_multipleDocuments;
+    bool        m_skipBadDocuments;
+    std::size_t m_documentOffset;
+
+    // parse-in-progress data
+    const char * m_source;
+    std::size_t  m_sourceSize;
+    std::size_t  m_sourceIndex;
+
+    // Helpers
+    /*
+    struct ParsingStates {
+        enum Enum {
+            kNone = 0,
+            kParsingEntireFile
+        };
+
+        ParsingStates () = delete;
+    };
+    //*/
+
+    void NotifyOfError (const char * message);
+    // RETURN: The size the pre-pass found for the container opening at
+    //   m_sourceIndex, or JsonStructuralIndex::s_unknownSize.
+    std::size_t ContainerSizeHere ();
+    // Bring the newline count up to m_sourceIndex.
+    void CountLines ();
+    // Count the rest of what was parsed of this buffer, and let go of it.
+    void FinishWithBuffer ();
+    // RETURN: false (with the error set) if one more container would nest
+    //   deeper than m_maxDepth.
+    bool CheckDepth ();
+
+    // Parse what's left of the current buffer.
+    bool ContinueBuffer ();
+    // Drop a malformed document and carry on with the next one, if asked to.
+    // RETURN: true if parsing can carry on.
+    bool SkipBadDocument ();
+    void ContinueSkippingToNewline ();
+    // ParseEntireFile(), reading ahead.
+    bool ParseReadingAhead (std::FILE * file, std::size_t bufferSize, Handler * dataCallback);
+
+    bool IsWhitespace (char c, bool newlinesCount) const;
+
+    void SkipWhitespace (bool alsoSkipNewlines);
+
+    // RETURN: Index of the next '"' or '\' at or after from, or m_sourceSize.
+    std::size_t FindStringStop (std::size_t from);
+
+    inline const char * CurrentName () const {
+        return m_nameSpan ? m_nameSpan : m_tempName.Data();
+    }
+    // Copy a zero-copy name into m_tempName, before its buffer goes away.
+    void SpillNameSpan ();
+
+    inline const char * NumberText () const {
+        return m_numberSpan ? m_numberSpan : m_tempData.Data();
+    }
+    inline std::size_t NumberTextLength () const {
+        return m_numberSpan ? static_cast<std::size_t>(m_source + m_sourceIndex - m_numberSpan) : m_tempDataIndex;
+    }
+    // Source characters already consumed as part of a number; only copied
+    //   once the number has left its span.
+    inline void AppendToNumberText (const char * data, std::size_t length) {
+        if (!m_numberSpan)
+            AppendToTempData(data, length);
+    }
+    // Copy the number read so far into m_tempData, before its buffer goes away.
+    void SpillNumberSpan ();
+
+    // Copy into the scratch buffers, growing them as needed.  Always leaves
+    //   room for a terminating NUL.
+    void AppendToTempName (const char * data, std::size_t length);
+    void AppendToTempData (const char * data, std::size_t length);
+    void AppendToTempData (char c);
+
+    //
+    // Parser worker functions
+    //
+    // Handle changes in state, temporary internal copies of data,
+    //    and callbacks to the user.
+    //
+
+    void BeginObject ();
+    void EndObject ();
+    void BeginArray ();
+    void EndArray ();
+
+    void BeginName ();
+    void ContinueName ();
+    void FinishName ();
+
+    // used by both name and data strings
+    void HandleEscapedCharacter ();
+
+    void BeginStringValue ();
+    void ContinueStringValue ();
+    // zero-copy fast path; false if the string has to be copied after all.
+    bool ContinueStringValueInPlace (std::size_t dataLen);
+    void FinishStringValue ();
+
+    void BeginNumberValue_AtLeadingNegative ();
+    void BeginNumberValue_AtLeadingZero ();
+    void BeginNumberValue_AtNormalDigit ();
+    void BeginNumberValue_AtExponentMarker ();
+    void ContinueNumberValue_AfterLeadingNegative ();
+    void ContinueNumberValue_AfterLeadingZero ();
+    void ContinueNumberValue_ReadingWholeDigits ();
+    void ContinueNumberValue_ReadingFractionalDigits ();
+    void ContinueNumberValue_AfterExponentMarker ();
+    void ContinueNumberValue_ReadingExponentDigits ();
+    void FinishNumberValueZero ();
+    void FinishNumberValueIntegral ();
+    void FinishNumberValueWithFractional ();
+
+    void BeginTrueValue ();
+    void ContinueTrueValue ();
+    void FinishTrueValue ();
+    void BeginFalseValue ();
+    void ContinueFalseValue ();
+    void FinishFalseValue ();
+
+    void BeginNullValue ();
+    void ContinueNullValue ();
+    void FinishNullValue ();
+
+    void ContinueSkippingContainer ();
+
+    // only called after the first value in an object/array.
+    void ClearNameAndDataBuffers ();
+
+public:
+    // Methods
+    BasicJsonParser ();
+    ~BasicJsonParser ();
+
+    // file [in/out]: Pointer to an already-opened file with read access in
+    //   "translate" mode.
+    // data_buffer [in/out]: If NULL, one will be allocated and freed
+    //   automatically.  Its size will be the system page size.
+    // fread_buffer_size_in_elements [in]: Number of elements in the given
+    //   buffer for reading in data.
+    // result [in/out]: Will hold the file starting at where it points.
+    //   If the DataMapMutator was already pointing at some place inside a file,
+    //   the file will be parsed into that location.
+    // RETURN: true on success, false on failure.
+    bool ParseEntireFile (
+        std::FILE *         file,
+        char *              freadBuffer,
+        std::size_t         freadBufferSizeInElements,
+        Handler *           dataCallback
+    );
+
+    // Parses the file at path as one buffer, memory-mapped rather than read
+    //   in, so nothing is copied and no token is split between buffers.
+    //   Files that can't be mapped, such as pipes, are read in chunks
+    //   through ParseEntireFile() instead.
+    // RETURN: true on success, false on failure.
+    bool ParseMappedFile (const char * path, Handler * dataCallback);
+
+    // PRE: If beginning on a new set of data, you must Reset() this first.
+    bool ParseBuffer (const char * buffer, std::size_t bufferSize, Handler * dataCallback);
+
+    // Call after the last ParseBuffer() of the data, so a root object that
+    //   was never closed is reported (ParseError_UnexpectedEndOfData).
+    //   ParseEntireFile() and ParseMappedFile() do this themselves.
+    // RETURN: true on success, false on failure.
+    bool FinishData ();
+
+    // Called from a handler's event, makes ParseBuffer() return right after
+    //   that event.  Everything about the buffer, including zero-copy
+    //   pointers into it, stays as it was until Resume() picks up where
+    //   parsing left off.  Only for use with ParseBuffer(); ParseEntireFile()
+    //   and ParseMappedFile() carry straight on.
+    inline void Pause ()                                { m_pauseRequested = true; }
+    // RETURN: true if the last ParseBuffer() or Resume() was paused with
+    //   input left in its buffer.
+    inline bool IsPaused () const                       { return m_paused; }
+    // Continue a paused buffer.  Returns like ParseBuffer().
+    bool Resume ();
+
+    // Skip the rest of the innermost open container.  Nothing inside it is
+    //   delivered, or checked beyond its brackets balancing and its strings
+    //   ending.  Its own EndObject()/EndArray() is still delivered.  Call
+    //   between events, e.g. while paused.
+    void SkipContainer ();
+
+    // Use Reset before you parse different data.  Such as if you want to parse
+    //   a totally different set of data; after a successful, failed, or
+    //   (user-)canceled parse.
+    void Reset ();
+
+    // Zero-copy mode.  Names and string values that lie entirely inside the
+    //   buffer being parsed, without escapes, are handed to the callback as
+    //   pointers into that buffer instead of being copied.  String values are
+    //   reported through CallbackInterface::GotStringSpan().  If
+    //   keepRawEscapes, string values with escapes are also handed over as-is
+    //   (flagged as such) rather than being copied out and unescaped.
+    // Tokens that cross a ParseBuffer() boundary are always copied.
+    void SetZeroCopy (bool enabled, bool keepRawEscapes = false);
+
+    // Structural indexing, which despite the name is a SIMD pre-scan and
+    //   not an index of structural positions to jump between: every token
+    //   is still read by the parser.  Each buffer is classified 64 bytes at
+    //   a time (with SIMD when the CPU supports it), and the parser uses
+    //   that only to get through long runs of whitespace and the insides of
+    //   long strings a block at a time.  Helps large buffers with long
+    //   strings.  Stretches packed with short strings are left to the
+    //   byte-by-byte path; those parse within about 1% of the speed they
+    //   do with it off.
+    // With scanThreads, large buffers (such as from ParseMappedFile()) are
+    //   classified on that many background threads, ahead of the parser.
+    void SetStructuralIndexing (bool enabled, std::size_t scanThreads = 0);
+
+    // Deferred numbers.  When enabled, numbers are validated but not
+    //   converted, and are reported through CallbackInterface::GotNumberRaw().
+    void SetDeferredNumbers (bool enabled);
+
+    // Container sizes.  When enabled, a buffer that starts a document (the
+    //   whole data given to ParseBuffer() at once, or ParseMappedFile())
+    //   gets a quick structural pre-pass first, and containers that close
+    //   within it are reported through CallbackInterface::BeginObjectSized()
+    //   and BeginArraySized(), so their handler can size storage up front.
+    //   Buffers that start partway through a document get no sizes.
+    // The pre-pass adds 10-15% to the parse, so it only pays if the handler
+    //   makes real use of the sizes.  JsonParserCallbackForDataMap doesn't
+    //   yet: DataMap has no way to reserve children, so the builder only
+    //   saves a placeholder node per empty container.  Leave it off for
+    //   DataMap building until DataMap gets a reserve call.
+    void SetContainerSizes (bool enabled);
+
+    // Multiple documents.  When enabled, the data may hold any number of
+    //   root objects one after another, such as JSON Lines (NDJSON).  Each
+    //   one's end is reported through CallbackInterface::EndDocument().  If
+    //   skipBadDocuments, a malformed document is reported through
+    //   CallbackInterface::SkippedDocument() instead of stopping the parse,
+    //   and parsing picks up again on the next line.
+    void SetMultipleDocuments (bool enabled, bool skipBadDocuments = false);
+
+    // Read-ahead.  With bufferCount of 2 or more, ParseEntireFile() reads the
+    //   file on a background thread into that many buffers of bufferSize
+    //   chars, so reading the next chunks overlaps parsing this one.  Its
+    //   own fread buffer then only gives the size, if bufferSize is 0.
+    //   Worth it when reads are slow (cold cache, network filesystems).  A
+    //   bufferCount of 0 or 1 turns it off.
+    void SetReadAhead (std::size_t bufferCount, std::size_t bufferSize = 0);
+
+    // Containers nested deeper than maxDepth (the root object being depth 1)
+    //   stop the parse with ParseError_MaxDepthExceeded.  Defaults to
+    //   s_defaultMaxDepth.  Depth itself costs a bit per level, so this is
+    //   only a guard against hostile or runaway input.
+    inline void SetMaxDepth (std::size_t maxDepth)     { m_maxDepth = maxDepth; }
+
+    inline ErrorStatus GetErrorCode () const           { return m_errorStatus; }
+    // The last error found since Reset().  code is NotStarted if none.
+    inline const ParseError & GetError () const        { return m_error; }
+
+    // Have each error handed to sink as it's found, or no one if null.
+    inline void SetErrorSink (ErrorSink * sink)        { m_errorSink = sink; }
+    // Print each error, with its row and column, to stderr.  Off by default;
+    //   meant for tools and debugging, not for servers.
+    inline void SetPrintErrors (bool enabled)          { m_printErrors = enabled; }
+
+    // Bytes parsed so far, across every ParseBuffer() since Reset().  After
+    //   an error, where the error was found.
+    inline std::size_t GetByteOffset () const          { return m_bufferOffset + m_sourceIndex; }
+    // The same position as a 1-based row and column (in bytes).  Newlines
+    //   are only counted when this is called, or a buffer is finished with.
+    void GetPosition (std::size_t * row, std::size_t * column);
+};
+
+#ifdef _MSC_VER
+#	pragma warning(push)
+    // Using fopen() in some places.  Not fopen_s; for cross-platform
+    //   compatibility.
+#	pragma warning(disable: 4996)
+#endif
+
+//=========================================================================
+inline bool JsonParserBase::TranslateEscapedCharacter (char escapeCode, char * result) {
+    char special_char = '\0';
+
+    switch (escapeCode) {
+        case '"':
+        case '\\':
+        case '/': special_char = escapeCode; break;
+
+        // backspace
+        case 'b': special_char = 0x08; break;
+        // formfeed
+        case 'f': special_char = 0x0C; break;
+
+        // newline
+        case 'n': special_char = 0x0A; break;
+        // carriage return
+        case 'r': special_char = 0x0D; break;
+
+        // horizontal tab
+        case 't': special_char = 0x09; break;
+
+        // includes unicode (u is followed by 4 hexadecimal digits), which isn't
+        //   supported yet.
+        default: return false;
+    }
+
+    if (result)
+        *result = special_char;
+    return true;
+}
+
+//=========================================================================
+template <typename Handler>
+void JsonParserBase::DeliverNumber (
+    Handler *           callback,
+    const char *        name,
+    std::size_t         nameLen,
+    const JsonDecimal & number,
+    const char *        text,
+    std::size_t         textLen,
+    NumberKind          kind
+) {
+    if (kind == NumberKind::Real) {
+        callback->GotDouble(name, nameLen, JsonNumbers::ToDouble(number, text, textLen));
+        return;
+    }
+
+    const int          intMax   = std::numeric_limits<int>::max();
+    const std::int64_t int64Max = std::numeric_limits<std::int64_t>::max();
+
+    // deliver through the narrowest callback that holds the value exactly
+    std::uint64_t magnitude = 0;
+    if (!JsonNumbers::WholeToUInt64(number, text, textLen, &magnitude)) {
+        callback->GotDouble(name, nameLen, JsonNumbers::ToDouble(number, text, textLen));
+    }
+    else if (!number.negative) {
+        if (magnitude <= static_cast<std::uint64_t>(intMax))
+            callback->GotInteger(name, nameLen, static_cast<int>(magnitude));
+        else if (magnitude <= static_cast<std::uint64_t>(int64Max))
+            callback->GotInt64(name, nameLen, static_cast<std::int64_t>(magnitude));
+        else
+            callback->GotUInt64(name, nameLen, magnitude);
+    }
+    else {
+        // -(max + 1) still fits each signed type
+        if (magnitude <= static_cast<std::uint64_t>(intMax) + 1)
+            callback->GotInteger(name, nameLen, static_cast<int>(-static_cast<std::int64_t>(magnitude)));
+        else if (magnitude <= static_cast<std::uint64_t>(int64Max) + 1)
+            callback->GotInt64(name, nameLen, -static_cast<std::int64_t>(magnitude - 1) - 1);
+        else
+            callback->GotDouble(name, nameLen, -static_cast<double>(magnitude));
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+BasicJsonParser<Handler>::BasicJsonParser ()
+    : m_tempName(s_initialNameCapacity)
+    , m_tempData(s_initialStringCapacity)
+    , m_deferNumbers(false)
+    , m_zeroCopy(false)
+    , m_keepRawEscapes(false)
+    , m_structuralIndex(nullptr)
+    , m_indexFrom(std::size_t(-1))
+    , m_readAheadBufferCount(0)
+    , m_readAheadBufferSize(0)
+    , m_findContainerSizes(false)
+    , m_nextContainerSize(0)
+    , m_maxDepth(s_defaultMaxDepth)
+    , m_errorSink(nullptr)
+    , m_printErrors(false)
+    , m_multipleDocuments(false)
+    , m_skipBadDocuments(false)
+{
+    Reset();
+}
+
+//=========================================================================
+template <typename Handler>
+BasicJsonParser<Handler>::~BasicJsonParser () {
+    delete m_structuralIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::ParseEntireFile (
+    std::FILE *         file,
+    char *              freadBuffer,
+    std::size_t         freadBufferSizeInElements,
+    Handler *           dataCallback
+) {
+    Reset();
+
+    // check for no file given
+    if (file == nullptr) {
+        m_errorStatus = ErrorStatus::Error_CantAccessData;
+        NotifyOfError(
+            "ParseEntireFile() was given a NULL file pointer.  "
+                "Please give a file with read access and in translate mode to be parsed."
+        );
+        return false;
+    }
+    // check for no storage destination
+    if (dataCallback == nullptr) {
+        m_errorStatus = ErrorStatus::Error_CantAccessData;
+        NotifyOfError(
+            "ParseEntireFile() was given a NULL handler pointer to send its results to.  "
+                "Please provide a valid handler."
+        );
+        return false;
+    }
+
+    if (m_readAheadBufferCount > 1) {
+        std::size_t bufferSize = m_readAheadBufferSize;
+        if (bufferSize == 0)
+            bufferSize = freadBuffer ? freadBufferSizeInElements : DefaultReadBufferSize();
+        return ParseReadingAhead(file, bufferSize, dataCallback);
+    }
+
+    // if no working buffer was given, make one
+    bool mustDeleteBufferAfter = (freadBuffer == nullptr);
+    if (mustDeleteBufferAfter) {
+        freadBufferSizeInElements = DefaultReadBufferSize();
+        freadBuffer = new char[freadBufferSizeInElements];
+    }
+
+    m_errorStatus = ErrorStatus::NotFinished;
+    while (m_parserStatus < ParserStatus::Done && m_errorStatus <  ErrorStatus::Error_Unspecified) {
+        std::size_t charsThisRead = std::fread(freadBuffer, sizeof(char), freadBufferSizeInElements, file);
+        // if we didn't read in as much as we wanted, check why
+        if (charsThisRead != freadBufferSizeInElements) {
+            // file reading error?
+            if (std::ferror(file)) {
+                m_errorStatus = ErrorStatus::Error_BadFileRead;
+                NotifyOfError(NULL);
+                break;
+            }
+            // otherwise, we reached the end of the file.  Checked below,
+            //   once this last bit has been parsed.
+        }
+
+        // pass our chunk of memory down to the worker function for parsing
+        ParseBuffer(freadBuffer, charsThisRead, dataCallback);
+        while (m_paused)
+            Resume();
+
+        if (std::feof(file))
+            FinishData();
+    }
+
+    // clean up our buffer, if the user didn't give us one
+    if (mustDeleteBufferAfter)
+        delete [] freadBuffer;
+
+    return m_errorStatus < ErrorStatus::Error_Unspecified;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::ParseReadingAhead (
+    std::FILE *         file,
+    std::size_t         bufferSize,
+    Handler *           dataCallback
+) {
+    JsonReadAhead readAhead(file, bufferSize, m_readAheadBufferCount);
+
+    // Each chunk is finished with once ParseBuffer() returns; anything still
+    //   needed from it has been copied out.
+    const char * chunk;
+    std::size_t  chunkSize;
+    m_errorStatus = ErrorStatus::NotFinished;
+    while (
+        m_parserStatus < ParserStatus::Done             &&
+        m_errorStatus  < ErrorStatus::Error_Unspecified &&
+        readAhead.Acquire(&chunk, &chunkSize)
+    ) {
+        ParseBuffer(chunk, chunkSize, dataCallback);
+        while (m_paused)
+            Resume();
+        readAhead.Release();
+    }
+
+    // ran out of data
+    if (m_parserStatus < ParserStatus::Done && m_errorStatus < ErrorStatus::Error_Unspecified) {
+        if (readAhead.HadReadError()) {
+            m_errorStatus = ErrorStatus::Error_BadFileRead;
+            NotifyOfError(NULL);
+        }
+        else
+            FinishData();
+    }
+
+    return m_errorStatus < ErrorStatus::Error_Unspecified;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::ParseMappedFile (const char * path, Handler * dataCallback) {
+    Reset();
+
+    // check for no path given
+    if (path == nullptr) {
+        m_errorStatus = ErrorStatus::Error_CantAccessData;
+        NotifyOfError("ParseMappedFile() was given a NULL path.");
+        return false;
+    }
+    // check for no storage destination
+    if (dataCallback == nullptr) {
+        m_errorStatus = ErrorStatus::Error_CantAccessData;
+        NotifyOfError(
+            "ParseMappedFile() was given a NULL handler pointer to send its results to.  "
+                "Please provide a valid handler."
+        );
+        return false;
+    }
+
+    JsonMappedFile mappedFile;
+    if (!mappedFile.Open(path)) {
+        // fall back on reading it in
+        std::FILE * file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            m_errorStatus = ErrorStatus::Error_CantAccessData;
+            NotifyOfError("ParseMappedFile() couldn't open the file it was given.");
+            return false;
+        }
+
+        const bool result = ParseEntireFile(file, nullptr, 0, dataCallback);
+        std::fclose(file);
+        return result;
+    }
+
+    ParseBuffer(mappedFile.Data(), mappedFile.Size(), dataCallback);
+    while (m_paused)
+        Resume();
+    FinishData();
+
+    return m_errorStatus < ErrorStatus::Error_Unspecified;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::ParseBuffer (const char * buffer, std::size_t bufferSize, Handler * dataCallback) {
+    // check for no buffer given
+    if (buffer == nullptr) {
+        m_errorStatus = ErrorStatus::Error_CantAccessData;
+        NotifyOfError("ParseBuffer() was given a NULL buffer pointer.");
+        return false;
+    }
+    // check for no storage destination
+    if (dataCallback == nullptr) {
+        m_errorStatus = ErrorStatus::Error_CantAccessData;
+        NotifyOfError(
+            "ParseBuffer() was given a NULL handler pointer to send its results to.  "
+                "Please provide a valid handler."
+        );
+        return false;
+    }
+
+    // a paused buffer that's being replaced
+    if (m_source)
+        FinishWithBuffer();
+
+    m_source       = buffer;
+    m_sourceSize   = bufferSize;
+    m_sourceIndex  = 0;
+    m_dataCallback = dataCallback;
+
+    // a buffer that starts between documents can't start inside a string
+    m_containerSizes.clear();
+    m_nextContainerSize = 0;
+    if (m_findContainerSizes && m_parserStatus == ParserStatus::NotStarted)
+        JsonStructuralIndex::FindContainerSizes(buffer, bufferSize, &m_containerSizes);
+
+    // small buffers aren't worth classifying up front
+    m_indexFrom = std::size_t(-1);
+    if (m_structuralIndex && bufferSize >= s_minIndexedBufferSize) {
+        m_structuralIndex->Attach(buffer, bufferSize);
+        m_indexFrom = m_structuralIndex->GetDenseEnd();
+    }
+
+    if (m_errorStatus == ErrorStatus::NotStarted)
+        m_errorStatus = ErrorStatus::NotFinished;
+
+    return ContinueBuffer();
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::Resume () {
+    if (!m_paused)
+        return m_errorStatus < ErrorStatus::Error_Unspecified;
+    return ContinueBuffer();
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::FinishData () {
+    // between documents is a fine place to stop
+    if (
+        m_multipleDocuments                                         &&
+        (
+            m_parserStatus == ParserStatus::NotStarted      ||
+            m_parserStatus == ParserStatus::SkippingToNewline
+        )                                                           &&
+        m_errorStatus < ErrorStatus::Error_Unspecified
+    ) {
+        m_errorStatus  = ErrorStatus::Done;
+        m_parserStatus = ParserStatus::FinishedAllData;
+        return true;
+    }
+
+    // the data ran out before the root object was closed
+    if (m_parserStatus < ParserStatus::Done && m_errorStatus < ErrorStatus::Error_Unspecified) {
+        m_errorStatus  = ErrorStatus::ParseError_UnexpectedEndOfData;
+        m_parserStatus = ParserStatus::Done;
+        NotifyOfError("The data ended before the root object was closed.");
+
+        // a cut-off last document is just another bad one
+        if (m_skipBadDocuments) {
+            std::size_t row, column;
+            GetPosition(&row, &column);
+            m_dataCallback->SkippedDocument(m_errorStatus, row, column);
+            m_errorStatus  = ErrorStatus::Done;
+            m_parserStatus = ParserStatus::FinishedAllData;
+        }
+    }
+
+    return m_errorStatus < ErrorStatus::Error_Unspecified;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::ContinueBuffer () {
+    m_pauseRequested = false;
+    m_paused         = false;
+
+    while (
+        (m_errorStatus < ErrorStatus::Error_Unspecified || SkipBadDocument()) &&
+        m_parserStatus != ParserStatus::Done            &&
+        m_parserStatus != ParserStatus::FinishedAllData &&
+        m_sourceIndex < m_sourceSize                    &&
+        !m_pauseRequested
+    ) {
+        // walk through buffer, parsing data
+        switch (m_parserStatus) {
+            // nothing parsed yet.  Only valid thing is the root object's start.
+            case ParserStatus::NotStarted: {
+                SkipWhitespace(true);
+                if (m_sourceIndex >= m_sourceSize)
+                    break;
+                // should have root object
+                if (m_source[m_sourceIndex] == '{') {
+                    m_documentOffset = GetByteOffset();
+                    if (m_errorStatus == ErrorStatus::Done)
+                        m_errorStatus = ErrorStatus::NotFinished;
+                    BeginObject();
+                }
+                // if we didn't begin the root object, error
+                else {
+                    m_errorStatus = ErrorStatus::ParseError_ExpectedBeginObject;
+                    m_parserStatus = ParserStatus::Done;
+                    NotifyOfError("All valid JSON data begins with the opening curly brace of the root, unnamed object.");
+                }
+            } break;
+
+            // An object has already begun.  Only valid things are the name of the
+            //   first name-value pair, or an object-terminating curly brace.
+            case ParserStatus::BeganObject: {
+                SkipWhitespace(true);
+                if (m_sourceIndex >= m_sourceSize)
+                    break;
+                // all object fields have names
+                if (m_source[m_sourceIndex] == '"')
+                    BeginName();
+                // objects can be empty
+                else if (m_source[m_sourceIndex] == '}')
+                    EndObject();
+                // nothing else is valid
+                else {
+                    m_errorStatus  = ErrorStatus::ParseError_ExpectedString;
+                    m_parserStatus = ParserStatus::Done;
+                    NotifyOfError(
+                        "Every field in an object is made up of a name-value pair.  "
+                            "Like this: { \"answer\" : 42 }\n"
+                            "Other possible error: Didn't terminate your empty object properly.  Do like this: { }"
+                    );
+                }
+                break;
+
+                // An array has already just begun, or an array value-separating comma
+                //   was encoutnered after a valid value in the same array.
+                //   Only valid things are...
+                //    - Skippable whitespace.
+                //    - string value-starting double quote.
+                //    - Numeric value-starting digit (or negative sign).
+                //    - true-starting 't'.
+                //    - false-starting 'f'.
+                //    - null-starting 'n'.
+                case ParserStatus::BeganArray:
+                case ParserStatus::NeedAnotherDataElement_InArray: {
+                    SkipWhitespace(true);
+                    if (m_sourceIndex >= m_sourceSize)
+                        break;
+
+                    switch (m_source[m_sourceIndex]) {
+                        // string value?
+                        case '"': {
+                            BeginStringValue();
+                        } break;
+                        // number opening negative sign?
+                        case '-': {
+                            m_parserStatus = ParserStatus::NumberSawLeadingNegativeSign;
+                            BeginNumberValue_AtLeadingNegative();
+                        } break;
+                        // number leading zero?
+                        case '0': {
+                            m_parserStatus = ParserStatus::NumberSawLeadingZero;
+                            BeginNumberValue_AtLeadingZero();
+                        } break;
+                        // number leading 1-9 digit?
+                        case '1':
+                        case '2':
+                        case '3':
+                        case '4':
+                        case '5':
+                        case '6':
+                        case '7':
+                        case '8':
+                        case '9': {
+                            m_parserStatus = ParserStatus::NumberReadingWholeDigits;
+                            BeginNumberValue_AtNormalDigit();
+                        } break;
+                        // bad attempt to start a fractional number?
+                        case '.': {
+                            m_parserStatus = ParserStatus::Done;
+                            m_errorStatus  = ErrorStatus::ParserError_PrematureDecimalPoint;
+                            NotifyOfError(
+                                "Numbers cannot start with a decimal point.  Begin them with a zero first (0.123)"
+                            );
+                        } break;
+                        // 'true' value?
+                        case 't': {
+                            BeginTrueValue();
+                        } break;
+                        // 'false' value?
+                        case 'f': {
+                            BeginFalseValue();
+                        } break;
+                        // 'null' value?
+                        case 'n': {
+                            BeginNullValue();
+                        } break;
+                        // child object value?
+                        case '{': {
+                            BeginObject();
+                        } break;
+                        // child array value?
+                        case '[': {
+                            BeginArray();
+                        } break;
+                        // arrays can be empty
+                        case ']': {
+                            if (m_parserStatus == ParserStatus::NeedAnotherDataElement_InArray) {
+                                m_parserStatus = ParserStatus::Done;
+                                m_errorStatus  = ErrorStatus::ParseError_ExpectedValue;
+                                NotifyOfError(
+                                    "Expected another value in Array.  Got end-of-array square bracket instead.  "
+                                        "Either give another value, or remove the last comma in the array."
+                                );
+                                break;
+                            }
+                            EndArray();
+                        } break;
+                        // TODO: Implement other value types.
+                        default: {
+                            m_errorStatus  = ErrorStatus::ParseError_ExpectedValue;
+                            m_parserStatus = ParserStatus::Done;
+                            NotifyOfError(
+                                "Saw an object's element's name, then the name-value separator.  "
+                                    "But no valid value came after that."
+                            );
+                        } break;
+                    } break; // end switch (m_source[m_sourceIndex])
+                } // end case ParserStatus::NeedAnotherDataElement_InArray:
+                // ^^^ intentional fall-through!
+
+                // We've already seen a name's opening double-quote.  Since we're
+                //   currently reading a name, keep reading in the name.  Until
+                //   double-quotes are again encountered.
+                case ParserStatus::ReadingName: {
+                    if (m_source[m_sourceIndex] == '"')
+                        FinishName();
+                    else
+                        ContinueName();
+                } break;
+
+                // After a name (which only occurs in name-value pairs), the only thing
+                //   we should see is a name-value-separating colon.
+                case ParserStatus::FinishedName: {
+                    SkipWhitespace(true);
+                    if (m_sourceIndex >= m_sourceSize)
+                        break;
+                    if (m_source[m_sourceIndex] == ':') {
+                        m_parserStatus = ParserStatus::SawNameValueSeparator;
+                        ++m_sourceIndex;
+                    }
+                    // otherwise, we have malformed data
+                    else {
+                        m_errorStatus  = ErrorStatus::ParseError_ExpectedNameValueSeparator;
+                        m_parserStatus = ParserStatus::Done;
+                        NotifyOfError(
+                            "Every name must be followed by the name-value separator (a colon).  "
+                                "Like this: { \"name\" : \"value\" }"
+                        );
+                    }
+                } break;
+
+                // After the name-value separater, we should see...
+                //   double-quote to begin a string value
+                //   digit 0-9 or the negative sign (no positive sign!) to begin a number
+                //   't' in 'true'  (must be lowercase)
+                //   'f' in 'false'  (must be lowercase)
+                //   'n' in 'null'  (must be lowercase)
+                case ParserStatus::SawNameValueSeparator: {
+                    SkipWhitespace(true);
+                    if (m_sourceIndex >= m_sourceSize)
+                        break;
+                    switch (m_source[m_sourceIndex]) {
+                        // string value?
+                        case '"': {
+                            BeginStringValue();
+                        } break;
+                        // number opening negative sign?
+                        case '-': {
+                            m_parserStatus = ParserStatus::NumberSawLeadingNegativeSign;
+                            BeginNumberValue_AtLeadingNegative();
+                        } break;
+                        // number leading zero?
+                        case '0': {
+                            m_parserStatus = ParserStatus::NumberSawLeadingZero;
+                            BeginNumberValue_AtLeadingZero();
+                        } break;
+                        // number leading 1-9 digit?
+                        case '1':
+                        case '2':
+                        case '3':
+                        case '4':
+                        case '5':
+                        case '6':
+                        case '7':
+                        case '8':
+                        case '9': {
+                            m_parserStatus = ParserStatus::NumberReadingWholeDigits;
+                            BeginNumberValue_AtNormalDigit();
+                        } break;
+                        // bad attempt to start a fractional number?
+                        case '.': {
+                            m_parserStatus = ParserStatus::Done;
+                            m_errorStatus = ErrorStatus::ParserError_PrematureDecimalPoint;
+                            NotifyOfError(
+                                "Numbers cannot start with a decimal point.  Begin them with a zero first (0.123)."
+                            );
+                        } break;
+                        // 'true' value?
+                        case 't': {
+                            BeginTrueValue();
+                        } break;
+                        // 'false' value?
+                        case 'f': {
+                            BeginFalseValue();
+                        } break;
+                        // 'null' value?
+                        case 'n': {
+                            BeginNullValue();
+                        } break;
+                        // child object value?
+                        case '{': {
+                            BeginObject();
+                        } break;
+                        // child array value?
+                        case '[': {
+                            BeginArray();
+                        } break;
+                        // TODO: Implement other value types.
+                        default: {
+                            m_errorStatus  = ErrorStatus::ParseError_ExpectedValue;
+                            m_parserStatus = ParserStatus::Done;
+                            NotifyOfError(
+                                "Saw an object's element's name, then the name-value separator.  "
+                                    "But no valid value came after that."
+                            );
+                        } break;
+                    } break; // end switch (m_source[m_sourceIndex])
+                } // end case ParserStatus::SawNameValueSeparator:
+                // ^^^ intentional fall-through!
+
+                // We've already seen a string value's opening double-quote.  Since we're
+                //   currently reading a string, keep reading in the string.  Until
+                //   double-quotes are encountered again.  This is broken up in this way
+                //   because the string may span a number of buffer-parse calls.
+                case ParserStatus::ReadingStringValue: {
+                    if (m_source[m_sourceIndex] == '"')
+                        FinishStringValue();
+                    else
+                        ContinueStringValue();
+                } break;
+
+                case ParserStatus::ReadingName_EscapedChar:
+                case ParserStatus::ReadingStringValue_EscapedChar: {
+                    HandleEscapedCharacter();
+                } break;
+
+                case ParserStatus::NumberSawLeadingNegativeSign: {
+                    ContinueNumberValue_AfterLeadingNegative();
+                } break;
+
+                case ParserStatus::NumberSawLeadingZero: {
+                    ContinueNumberValue_AfterLeadingZero();
+                    /*
+                    // begin floating-pointer number?
+                    if (m_source[m_sourceIndex] == '.') {
+                    }
+                    // end number at just zero?
+                    else if (
+                        m_source[m_sourceIndex] == ',' ||
+                        m_source[m_sourceIndex] == '}' ||
+                        m_source[m_sourceIndex] == ']' ||
+                        IsWhitespace(m_source[m_sourceIndex], true)
+                    ) {
+                    }
+                    else {
+                    }
+                    //*/
+                } break;
+
+                case ParserStatus::NumberReadingWholeDigits: {
+                    switch (m_source[m_sourceIndex]) {
+                        case '0':
+                        case '1':
+                        case '2':
+                        case '3':
+                        case '4':
+                        case '5':
+                        case '6':
+                        case '7':
+                        case '8':
+                        case '9': {
+                            ContinueNumberValue_ReadingWholeDigits();
+                        } break;
+
+                        case '.': {
+                            m_parserStatus = ParserStatus::NumberSawDecimalPoint;
+                            AppendToNumberText(m_source + m_sourceIndex, 1);
+                            ++m_sourceIndex;
+                        } break;
+
+                        case ',':
+                        case '}':
+                        case ']': {
+                            m_parserStatus = ParserStatus::FinishedValue;
+                            FinishNumberValueIntegral();
+                        } break;
+
+                        case 'e':
+                        case 'E': {
+                            BeginNumberValue_AtExponentMarker();
+                        } break;
+
+                        default: {
+                            if (IsWhitespace(m_source[m_sourceIndex], true)) {
+                                m_parserStatus = ParserStatus::FinishedValue;
+                                FinishNumberValueIntegral();
+                            }
+                            else {
+                                m_errorStatus  = ErrorStatus::ParseError_ExpectedDigitOrDecimalOrEndOfNumber;
+                                m_parserStatus = ParserStatus::Done;
+                                NotifyOfError(
+                                    "Was reading integral digits in a number.  "
+                                        "Expected more digits, decimal point, exponent, or "
+                                        "end of number by \'}\', \']\', or \',\'."
+                                );
+                            }
+                        } break;
+                    } break; // end sub-switch
+                } // end case
+
+                case ParserStatus::NumberSawDecimalPoint: {
+                    if (m_source[m_sourceIndex] < '0' || m_source[m_sourceIndex] > '9') {
+                        m_errorStatus = ErrorStatus::ParserError_UnfinishedFractionalNumber;
+                        m_parserStatus = ParserStatus::Done;
+                        NotifyOfError(
+                            "Fractional numbers must have digits after the decimal point.  "
+                                "So \"0.\" is not valid, but \"0.0\" is."
+                        );
+                        break;
+                    }
+
+                    ContinueNumberValue_ReadingFractionalDigits();
+                    m_parserStatus = ParserStatus::NumberReadingFractionalDigits;
+                } break;
+
+                case ParserStatus::NumberReadingFractionalDigits: {
+                    const char c = m_source[m_sourceIndex];
+                    if (c >= '0' && c <= '9') {
+                        ContinueNumberValue_ReadingFractionalDigits();
+                    }
+                    else if (c == 'e' || c == 'E') {
+                        BeginNumberValue_AtExponentMarker();
+                    }
+                    else if (c == ',' || c == '}' || c == ']' || IsWhitespace(c, true)) {
+                        FinishNumberValueWithFractional();
+                    }
+                    else {
+                        m_errorStatus  = ErrorStatus::ParseError_ExpectedDigitOrEndOfNumber;
+                        m_parserStatus = ParserStatus::Done;
+                        NotifyOfError(
+                            "Fractional portion of number terminated incorrectly.  "
+                                "Should end in an exponent, whitespace, array-finishing ']', "
+                                "object-finishing '}', or value-separating ','."
+                        );
+                    }
+                } break;
+
+                case ParserStatus::NumberSawExponentMarker:
+                case ParserStatus::NumberSawExponentSign: {
+                    ContinueNumberValue_AfterExponentMarker();
+                } break;
+
+                case ParserStatus::NumberReadingExponentDigits: {
+                    const char c = m_source[m_sourceIndex];
+                    if (c >= '0' && c <= '9') {
+                        ContinueNumberValue_ReadingExponentDigits();
+                    }
+                    else if (c == ',' || c == '}' || c == ']' || IsWhitespace(c, true)) {
+                        FinishNumberValueWithFractional();
+                    }
+                    else {
+                        m_errorStatus  = ErrorStatus::ParseError_ExpectedDigitOrEndOfNumber;
+                        m_parserStatus = ParserStatus::Done;
+                        NotifyOfError(
+                            "Exponent of number terminated incorrectly.  "
+                                "Should end in whitespace, array-finishing ']', object-finishing '}', "
+                                "or value-separating ','."
+                        );
+                    }
+                } break;
+
+                case ParserStatus::ReadingTrueValue: {
+                    if (m_tempDataIndex < 4)
+                        ContinueTrueValue();
+                    else
+                        FinishTrueValue();
+                } break;
+
+                case ParserStatus::ReadingFalseValue: {
+                    if (m_tempDataIndex < 5)
+                        ContinueFalseValue();
+                    else
+                        FinishFalseValue();
+                } break;
+
+                //case ParserStatus::ReadingFalseValue:
+                //break;
+
+                case ParserStatus::ReadingNullValue: {
+                    if (m_tempDataIndex < 4)
+                        ContinueNullValue();
+                    else
+                        FinishNullValue();
+                } break;
+
+                // Just finished a value (of any kind).  We should see...
+                //   If currently in an object:
+                //    - whitespace that can be ignored.
+                //    - value-separating comma.
+                //    - object-terminating curly brace.
+                //   If currently in an array:
+                //    - whitespace that can be ignored.
+                //    - value-separating comma.
+                //    - array-terminating square bracket.
+                case ParserStatus::FinishedValue: {
+                    SkipWhitespace(true);
+                    if (m_sourceIndex >= m_sourceSize)
+                        break;
+                    // value-separating comma?
+                    if (m_source[m_sourceIndex] == ',') {
+                        ClearNameAndDataBuffers();
+                        ++m_sourceIndex;
+                        if (m_objectTypeStack.Top())
+                            m_parserStatus = ParserStatus::NeedAnotherDataElement_InObject;
+                        else
+                            m_parserStatus = ParserStatus::NeedAnotherDataElement_InArray;
+                    }
+                    // object-terminating curly brace?
+                    else if (m_source[m_sourceIndex] == '}') {
+                        EndObject();
+                    }
+                    // array-terminating square bracket?
+                    else if (m_source[m_sourceIndex] == ']') {
+                        EndArray();
+                    }
+                    // otherwise, unexpected invalid data
+                    else {
+                        m_errorStatus  = ErrorStatus::ParseError_ExpectedValueSeparatorOrEndOfContainer;
+                        m_parserStatus = ParserStatus::Done;
+                        // were we in an object?
+                        if (m_objectTypeStack.Top()) {
+                            NotifyOfError(
+                                "Every name-value pair in an object must be followed by either the name-value "
+                                    "separating comma (,), or the termination of the containing object (})."
+                            );
+                        }
+                        // otherwise, we were in an array
+                        else {
+                            NotifyOfError(
+                                "Every value in an array must be followed by either the value separating "
+                                    "comma (,), or the termination of the containing array (])"
+                            );
+                        }
+                    }
+                } break;
+
+                // Just got a value-separating comma.  Only valid things are...
+                //    - Skippable whitespace.
+                //    - Name-starting double quotes.
+                case ParserStatus::NeedAnotherDataElement_InObject: {
+                    SkipWhitespace(true);
+                    if (m_sourceIndex >= m_sourceSize)
+                        break;
+                    // all object fields have names, or it could be an array's string
+                    if (m_source[m_sourceIndex] == '"')
+                        BeginName();
+                    // can't end the object when we're looking for another value
+                    else if (m_source[m_sourceIndex] == '}') {
+                        m_parserStatus = ParserStatus::Done;
+                        m_errorStatus  = ErrorStatus::ParseError_ExpectedString;
+                        NotifyOfError(
+                            "Ended object too early.  Already saw a comma, which means another item is expected.  "
+                                "Like this: { \"item1\" : 1, \"item2\" : 2 }"
+                        );
+                    }
+                    // nothing else is valid
+                    else {
+                        m_parserStatus = ParserStatus::Done;
+                        m_errorStatus = ErrorStatus::ParseError_ExpectedString;
+                        NotifyOfError(
+                            "After a value-separating comma in an object, the next element must be a name-value pair.  "
+                                "Like this: { \"foo\" : 1, \"bar\" : 2 }"
+                        );
+                    }
+                } break;
+
+                // SkipContainer() was called; scanning for the end of the
+                //   container, possibly over several buffers.
+                case ParserStatus::SkippingContainer: {
+                    ContinueSkippingContainer();
+                } break;
+
+                case ParserStatus::SkippingToNewline: {
+                    ContinueSkippingToNewline();
+                } break;
+
+                // TODO: Check for more data, and error if more is encountered.
+                //   More data after all is finished probably means the user has
+                //   mis-matching braces.  Or more than one root object.
+                case ParserStatus::FinishedAllData: {
+                    m_sourceIndex  = m_sourceSize;
+                    m_parserStatus = ParserStatus::Done;
+                } break;
+
+				case ParserStatus::Done: {
+					// Shouldn't get calling back into this loop if we're already Done.
+					// Could error, but this also doesn't break anything.
+				} break;
+            } // end case ParserStatus::BeganObject:
+        } // end switch (m_parserStatus)
+    } // end while (parser status, etc.)
+
+    // paused with input left: the buffer is still ours, spans and all.
+    m_paused         = m_pauseRequested && m_sourceIndex < m_sourceSize;
+    m_pauseRequested = false;
+    if (m_paused)
+        return m_errorStatus < ErrorStatus::Error_Unspecified;
+
+    // the caller may free the buffer as soon as this returns
+    if (m_indexFrom != std::size_t(-1))
+        m_structuralIndex->Detach();
+
+    // a zero-copy name can't outlive the caller's buffer, and its value may
+    //   not arrive until the next one.
+    if (m_nameSpan)
+        SpillNameSpan();
+    // same for a number that may continue in the next buffer
+    if (m_numberSpan)
+        SpillNumberSpan();
+
+    FinishWithBuffer();
+
+    return m_errorStatus < ErrorStatus::Error_Unspecified;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::Reset () {
+    m_errorStatus   = ErrorStatus::NotStarted;
+    m_parserStatus  = ParserStatus::NotStarted;
+    m_tempName.Data()[0] = '\0';
+    m_tempData.Data()[0] = '\0';
+    m_tempNameIndex = 0;
+    m_tempDataIndex = 0;
+    m_nameSpan      = nullptr;
+    m_numberSpan    = nullptr;
+    m_number.Clear();
+    //m_dataCallback  = nullptr;
+    m_sourceSize    = 0;
+    m_sourceIndex   = 0;
+
+    // a paused buffer may be freed after this
+    if (m_structuralIndex)
+        m_structuralIndex->Detach();
+    m_indexFrom = std::size_t(-1);
+
+    m_pauseRequested = false;
+    m_paused         = false;
+    m_skipDepth      = 0;
+    m_skipInString   = false;
+    m_skipEscaped    = false;
+
+    m_containerSizes.clear();
+    m_nextContainerSize = 0;
+
+    m_source         = nullptr;
+    m_bufferOffset   = 0;
+    m_countedIndex   = 0;
+    m_countedRows    = 0;
+    m_lineStart      = 0;
+    m_documentOffset = 0;
+
+    m_error.code         = ErrorStatus::NotStarted;
+    m_error.offset       = 0;
+    m_error.message      = "";
+    m_error.context[0]   = '\0';
+    m_error.contextIndex = 0;
+
+    m_objectTypeStack.Clear();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SetZeroCopy (bool enabled, bool keepRawEscapes) {
+    m_zeroCopy       = enabled;
+    m_keepRawEscapes = enabled && keepRawEscapes;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SetDeferredNumbers (bool enabled) {
+    m_deferNumbers = enabled;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SetContainerSizes (bool enabled) {
+    m_findContainerSizes = enabled;
+    if (!enabled) {
+        // let go of the memory a large buffer needed
+        std::vector<JsonContainerSize>().swap(m_containerSizes);
+        m_nextContainerSize = 0;
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+std::size_t BasicJsonParser<Handler>::ContainerSizeHere () {
+    while (
+        m_nextContainerSize < m_containerSizes.size() &&
+        m_containerSizes[m_nextContainerSize].offset < m_sourceIndex
+    )
+        ++m_nextContainerSize;
+
+    if (
+        m_nextContainerSize < m_containerSizes.size() &&
+        m_containerSizes[m_nextContainerSize].offset == m_sourceIndex
+    )
+        return m_containerSizes[m_nextContainerSize++].size;
+    return JsonStructuralIndex::s_unknownSize;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SetReadAhead (std::size_t bufferCount, std::size_t bufferSize) {
+    m_readAheadBufferCount = bufferCount;
+    m_readAheadBufferSize  = bufferSize;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SetStructuralIndexing (bool enabled, std::size_t scanThreads) {
+    if (enabled && !m_structuralIndex)
+        m_structuralIndex = new JsonStructuralIndex();
+    else if (!enabled) {
+        delete m_structuralIndex;
+        m_structuralIndex = nullptr;
+    }
+    if (m_structuralIndex)
+        m_structuralIndex->SetScanThreads(scanThreads);
+    m_indexFrom = std::size_t(-1);
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::NotifyOfError (const char * message) {
+    m_error.code    = m_errorStatus;
+    m_error.offset  = GetByteOffset();
+    m_error.message = message ? message : StatusMessage(m_errorStatus);
+
+    // the bytes either side, while the buffer is still ours
+    std::size_t before = 0;
+    std::size_t after  = 0;
+    if (m_source) {
+        before = std::min(m_sourceIndex, s_errorContextSize / 2);
+        after  = std::min(m_sourceSize - m_sourceIndex, s_errorContextSize - before);
+        std::memcpy(m_error.context, m_source + m_sourceIndex - before, before + after);
+    }
+    m_error.context[before + after] = '\0';
+    m_error.contextIndex            = before;
+
+    if (m_errorSink)
+        m_errorSink->GotError(m_error);
+
+    if (m_printErrors) {
+        std::size_t row, column;
+        GetPosition(&row, &column);
+        PrintError(row, column, m_error.message);
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::CountLines () {
+    const void * newline;
+    while (
+        m_countedIndex < m_sourceIndex &&
+        (newline = std::memchr(m_source + m_countedIndex, '\n', m_sourceIndex - m_countedIndex)) != nullptr
+    ) {
+        m_countedIndex = static_cast<const char *>(newline) - m_source + 1;
+        m_lineStart    = m_bufferOffset + m_countedIndex;
+        ++m_countedRows;
+    }
+    m_countedIndex = m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishWithBuffer () {
+    CountLines();
+    m_bufferOffset += m_sourceIndex;
+    m_source        = nullptr;
+    m_sourceSize    = 0;
+    m_sourceIndex   = 0;
+    m_countedIndex  = 0;
+
+    m_containerSizes.clear();
+    m_nextContainerSize = 0;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::GetPosition (std::size_t * row, std::size_t * column) {
+    CountLines();
+    *row    = m_countedRows + 1;
+    *column = GetByteOffset() - m_lineStart + 1;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::IsWhitespace (char c, bool newlinesCount) const {
+    if (newlinesCount) {
+        switch (c) {
+            case ' ':
+            case 0x09: // TAB (horizontal tab)
+            case 0x0A: // LF  (NL line feed, new line)
+            case 0x0D: // CR  (carriage return)
+                return true;
+        }
+        // break not needed
+    }
+    // if newlines don't count, only space and TAB are accepted
+    else if (c == ' ' || c == 0x09) {
+        return true;
+    }
+
+    return false;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SkipWhitespace (bool alsoSkipNewlines) {
+    // Most runs of whitespace are empty or a single space, so get past those
+    //   just as the byte-by-byte loop would, and only go to the index if
+    //   there's more.
+    if (m_sourceIndex >= m_sourceSize || !IsWhitespace(m_source[m_sourceIndex], alsoSkipNewlines))
+        return;
+    ++m_sourceIndex;
+
+    if (
+        m_sourceIndex >= m_indexFrom     &&
+        alsoSkipNewlines                 &&
+        m_sourceIndex < m_sourceSize     &&
+        IsWhitespace(m_source[m_sourceIndex], true)
+    ) {
+        m_sourceIndex = m_structuralIndex->FindNonWhitespace(m_sourceIndex);
+        m_indexFrom   = m_structuralIndex->GetDenseEnd();
+        return;
+    }
+
+    while (m_sourceIndex < m_sourceSize && IsWhitespace(m_source[m_sourceIndex], alsoSkipNewlines))
+        ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+std::size_t BasicJsonParser<Handler>::FindStringStop (std::size_t from) {
+    // Most strings are short, and a few byte compares beat a trip to the
+    //   index for those.  Only longer ones go on to use it, and not in a
+    //   dense stretch, where they're all short.
+    std::size_t scanEnd = m_sourceSize;
+    if (from >= m_indexFrom && from + s_shortStringScan < m_sourceSize)
+        scanEnd = from + s_shortStringScan;
+
+    while (from < scanEnd && m_source[from] != '\\' && m_source[from] != '"')
+        ++from;
+
+    if (from < scanEnd || from >= m_sourceSize)
+        return from;
+    from        = m_structuralIndex->FindStringStop(from);
+    m_indexFrom = m_structuralIndex->GetDenseEnd();
+    return from;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SpillNameSpan () {
+    const std::size_t nameLen = m_tempNameIndex;
+    m_tempNameIndex = 0;
+    AppendToTempName(m_nameSpan, nameLen);
+    m_tempName.Data()[m_tempNameIndex] = '\0';
+    m_nameSpan = nullptr;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SpillNumberSpan () {
+    m_tempDataIndex = 0;
+    AppendToTempData(m_numberSpan, NumberTextLength());
+    m_numberSpan = nullptr;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::AppendToTempName (const char * data, std::size_t length) {
+    m_tempName.Reserve(m_tempNameIndex + length + 1);
+    std::memcpy(m_tempName.Data() + m_tempNameIndex, data, length);
+    m_tempNameIndex += length;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::AppendToTempData (const char * data, std::size_t length) {
+    m_tempData.Reserve(m_tempDataIndex + length + 1);
+    std::memcpy(m_tempData.Data() + m_tempDataIndex, data, length);
+    m_tempDataIndex += length;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::AppendToTempData (char c) {
+    m_tempData.Reserve(m_tempDataIndex + 2);
+    m_tempData.Data()[m_tempDataIndex] = c;
+    ++m_tempDataIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginObject () {
+    //SkipWhitespace(true);
+    // if we have the right character, it's okay to begin the object
+    //if (m_source[m_sourceIndex] == '{') {
+        if (!CheckDepth())
+            return;
+        const std::size_t size = m_containerSizes.empty() ? JsonStructuralIndex::s_unknownSize : ContainerSizeHere();
+        // update internal status
+        m_parserStatus = ParserStatus::BeganObject;
+        ++m_sourceIndex;
+        // object stack tracking
+        m_objectTypeStack.Push(true);
+        // callback
+        if (size != JsonStructuralIndex::s_unknownSize)
+            m_dataCallback->BeginObjectSized(CurrentName(), m_tempNameIndex, size);
+        else
+            m_dataCallback->BeginObject(CurrentName(), m_tempNameIndex);
+        //return true;
+    //}
+
+    //return false;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::CheckDepth () {
+    if (m_objectTypeStack.Size() < m_maxDepth)
+        return true;
+
+    m_parserStatus = ParserStatus::Done;
+    m_errorStatus  = ErrorStatus::ParseError_MaxDepthExceeded;
+    NotifyOfError("Containers are nested deeper than the parser's maximum depth (see SetMaxDepth()).");
+    return false;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::EndObject () {
+    // if we're not in an object, someone ended an array with the wrong thing.
+    if (!m_objectTypeStack.Top()) {
+        m_parserStatus = ParserStatus::Done;
+        m_errorStatus  = ErrorStatus::ParseError_ExpectedEndOfArray;
+        NotifyOfError(
+            "Array terminated improperly (used curly brace).  Use the square bracket to do so instead.  "
+                "Like this: [ 8, 16 ]"
+        );
+        return;
+    }
+
+    m_objectTypeStack.Pop();
+    // if we've run the stack out, all data is now finished.  We have a special
+    //   state for this, other than kDone.  This is so if more data is
+    //   encountered after, we can warn the user of mis-matching braces.
+    //   With multiple documents, go back to waiting for the next root object.
+    if (m_objectTypeStack.Empty()) {
+        m_parserStatus = m_multipleDocuments ? ParserStatus::NotStarted : ParserStatus::FinishedAllData;
+        m_errorStatus = ErrorStatus::Done;
+        // the next root object has no name
+        if (m_multipleDocuments)
+            ClearNameAndDataBuffers();
+    }
+    else
+        m_parserStatus = ParserStatus::FinishedValue;
+
+    ++m_sourceIndex;
+
+    // callback
+    m_dataCallback->EndObject();
+    if (m_objectTypeStack.Empty() && m_multipleDocuments)
+        m_dataCallback->EndDocument();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginArray () {
+    if (!CheckDepth())
+        return;
+    const std::size_t size = m_containerSizes.empty() ? JsonStructuralIndex::s_unknownSize : ContainerSizeHere();
+    // update internal status
+    m_parserStatus = ParserStatus::BeganArray;
+    ++m_sourceIndex;
+    // object stack tracking
+    m_objectTypeStack.Push(false);
+    // callback
+    if (size != JsonStructuralIndex::s_unknownSize)
+        m_dataCallback->BeginArraySized(CurrentName(), m_tempNameIndex, size);
+    else
+        m_dataCallback->BeginArray(CurrentName(), m_tempNameIndex);
+
+    ClearNameAndDataBuffers();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::EndArray () {
+    // if we're not in an array, someone ended an object with the wrong thing.
+    if (m_objectTypeStack.Top()) {
+        m_parserStatus = ParserStatus::Done;
+        m_errorStatus  = ErrorStatus::ParseError_ExpectedEndOfObject;
+        NotifyOfError(
+            "Object terminated improperly (used square bracket).  Use the curly brace to do so instead.  "
+                "Like this: { \"foo\": 8 }"
+        );
+        return;
+    }
+
+    m_objectTypeStack.Pop();
+    // if we've run the stack out, all data is now finished, but something is
+    //   very wrong.  The root container must be an object, not an array.
+    if (m_objectTypeStack.Empty()) {
+        m_parserStatus = ParserStatus::Done;
+        m_errorStatus  = ErrorStatus::ParseError_BadStructure;
+        NotifyOfError(
+            "Encountered end of all data, but root-most object was an array.  Should have been an object.  "
+                "How did you even get to this state?"
+        );
+        return;
+    }
+    else
+        m_parserStatus = ParserStatus::FinishedValue;
+
+    ++m_sourceIndex;
+
+    // callback
+    m_dataCallback->EndArray();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginName () { 
+    // update internal status
+    m_parserStatus  = ParserStatus::ReadingName;
+    m_tempNameIndex = 0;
+    m_nameSpan      = nullptr;
+
+    // get past the opening double-quote
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueName () {
+    // read name, while watching for both end of buffer, and end of string
+    const std::size_t nameLen = FindStringStop(m_sourceIndex) - m_sourceIndex;
+
+    // zero-copy: the whole name is in this buffer, and nothing (such as an
+    //   escape) has been collected for it yet.  Point at it where it lies.
+    if (
+        m_zeroCopy                              &&
+        m_tempNameIndex == 0                    &&
+        m_sourceIndex + nameLen < m_sourceSize  &&
+        m_source[m_sourceIndex + nameLen] == '"'
+    ) {
+        m_nameSpan      = m_source + m_sourceIndex;
+        m_tempNameIndex = nameLen;
+        m_sourceIndex   += nameLen;
+        FinishName();
+        return;
+    }
+
+    // copy found name into temp buffer for holding
+    AppendToTempName(m_source + m_sourceIndex, nameLen);
+
+    if (m_sourceIndex + nameLen < m_sourceSize && m_source[m_sourceIndex + nameLen] == '\\') {
+        m_parserStatus = ParserStatus::ReadingName_EscapedChar;
+        // skip past the escape sequence-initiating backslash
+        ++m_sourceIndex;
+    }
+
+    m_sourceIndex += nameLen;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishName () {
+    if (!m_nameSpan)
+        m_tempName.Data()[m_tempNameIndex] = '\0';
+    m_parserStatus = ParserStatus::FinishedName;
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginStringValue () {
+    // update internal status
+    m_parserStatus  = ParserStatus::ReadingStringValue;
+    m_tempDataIndex = 0;
+    // get past the opening double-quote
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueStringValue () {
+    // read string value, while watching for both end of buffer,
+    //   and end of string
+    const std::size_t dataLen = FindStringStop(m_sourceIndex) - m_sourceIndex;
+
+    // zero-copy: nothing collected for this string yet, so if it also ends
+    //   in this buffer it can be handed over where it lies.
+    if (m_zeroCopy && m_tempDataIndex == 0 && ContinueStringValueInPlace(dataLen))
+        return;
+
+    // copy found string into temp buffer for holding
+    AppendToTempData(m_source + m_sourceIndex, dataLen);
+
+    if (m_sourceIndex + dataLen < m_sourceSize && m_source[m_sourceIndex + dataLen] == '\\') {
+        m_parserStatus = ParserStatus::ReadingStringValue_EscapedChar;
+        // skip past the escape sequence-initiating backslash
+        ++m_sourceIndex;
+    }
+
+    m_sourceIndex += dataLen;
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::ContinueStringValueInPlace (std::size_t dataLen) {
+    std::size_t end        = m_sourceIndex + dataLen;
+    bool   hasEscapes = false;
+
+    // if asked to, carry on past escapes without resolving them.  Anything
+    //   unusual (bad escape, escape split across buffers) is left to the
+    //   regular path, which also reports errors.
+    while (
+        m_keepRawEscapes                          &&
+        end + 1 < m_sourceSize                    &&
+        m_source[end] == '\\'                     &&
+        TranslateEscapedCharacter(m_source[end + 1], nullptr)
+    ) {
+        hasEscapes = true;
+        end = FindStringStop(end + 2);
+    }
+
+    if (end >= m_sourceSize || m_source[end] != '"')
+        return false;
+
+    const char * value    = m_source + m_sourceIndex;
+    const std::size_t valueLen = end - m_sourceIndex;
+
+    m_parserStatus   = ParserStatus::FinishedValue;
+    m_sourceIndex    = end + 1;
+    m_dataCallback->GotStringSpan(CurrentName(), m_tempNameIndex, value, valueLen, hasEscapes);
+
+    return true;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::HandleEscapedCharacter () {
+    char special_char = '\0';
+
+    if (!TranslateEscapedCharacter(m_source[m_sourceIndex], &special_char)) {
+        m_parserStatus = ParserStatus::Done;
+        // unicode (u is followed by 4 hexadecimal digits
+        if (m_source[m_sourceIndex] == 'u') {
+            m_errorStatus  = ErrorStatus::ParseError_SixCharacterEscapeSequenceNotYetSupported;
+            NotifyOfError("Six-character escape sequences are not yet supported.  An example of this is \"\\u005C\".");
+        }
+        else {
+            m_errorStatus  = ErrorStatus::ParseError_InvalidEscapedCharacter;
+            NotifyOfError(
+                "Invalid escaped character.  "
+                    "The only valid ones are \\\", \\\\, \\/, \\b, \\f, \\n, \\r, \\t.  "
+                    "\\uXXXX is also not yet supported."
+            );
+        }
+        return;
+    }
+
+    if (m_parserStatus == ParserStatus::ReadingName_EscapedChar) {
+        AppendToTempName(&special_char, 1);
+        m_parserStatus = ParserStatus::ReadingName;
+    }
+    // reading string value with an escaped character
+    else {
+        AppendToTempData(special_char);
+        m_parserStatus = ParserStatus::ReadingStringValue;
+    }
+
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishStringValue () {
+    m_tempData.Data()[m_tempDataIndex] = '\0';
+    m_parserStatus = ParserStatus::FinishedValue;
+    ++m_sourceIndex;
+    // notify user of new data.  Doesn't matter if we're in an object or an
+    //   array, since m_tempName will appropriately be pointing at an empty
+    //   string (not NULL pointer, but empty string) iff we're in an array.
+    if (m_zeroCopy)
+        m_dataCallback->GotStringSpan(CurrentName(), m_tempNameIndex, m_tempData.Data(), m_tempDataIndex, false);
+    else
+        m_dataCallback->GotString(CurrentName(), m_tempNameIndex, m_tempData.Data(), m_tempDataIndex);
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginNumberValue_AtLeadingNegative () {
+    // internal status already updated by caller (parse buffer)
+    m_tempDataIndex = 0;
+    m_numberSpan    = m_source + m_sourceIndex;
+    m_number.Clear();
+    m_number.negative = true;
+    //ContinueNumberValue_AfterLeadingNegative();
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginNumberValue_AtLeadingZero () {
+    // internal status already updated by caller (parse buffer)
+    m_tempDataIndex = 0;
+    m_numberSpan    = m_source + m_sourceIndex;
+    m_number.Clear();
+    //ContinueNumberValue_AfterLeadingZero();
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginNumberValue_AtNormalDigit () {
+    // internal status already updated by caller (parse buffer)
+    m_tempDataIndex = 0;
+    m_numberSpan    = m_source + m_sourceIndex;
+    m_number.Clear();
+    ContinueNumberValue_ReadingWholeDigits();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginNumberValue_AtExponentMarker () {
+    // whole or fractional digits were already read; this is the 'e' or 'E'
+    m_parserStatus = ParserStatus::NumberSawExponentMarker;
+    AppendToNumberText(m_source + m_sourceIndex, 1);
+    ++m_sourceIndex;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNumberValue_AfterLeadingNegative () {
+    switch (m_source[m_sourceIndex]) {
+        case '0': {
+            m_parserStatus  = ParserStatus::NumberSawLeadingZero;
+            AppendToNumberText(m_source + m_sourceIndex, 1);
+            ++m_sourceIndex;
+        } break;
+
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9': {
+            m_parserStatus  =  ParserStatus::NumberReadingWholeDigits;
+            ContinueNumberValue_ReadingWholeDigits();
+        } break;
+
+        default: {
+            m_parserStatus = ParserStatus::Done;
+            m_errorStatus  = ErrorStatus::ParseError_ExpectedDigit;
+            NotifyOfError("Expected 0-9 digit while reading number (just read leading '-' sign).");
+        } break;
+    } // end switch
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNumberValue_AfterLeadingZero () {
+    switch (m_source[m_sourceIndex]) {
+        case '.': {
+            m_parserStatus = ParserStatus::NumberSawDecimalPoint;
+            // the leading zero (and sign) are already held
+            AppendToNumberText(m_source + m_sourceIndex, 1);
+            ++m_sourceIndex;
+        } break;
+
+        case 'e':
+        case 'E': {
+            BeginNumberValue_AtExponentMarker();
+        } break;
+
+        case ',':
+        case '}':
+        case ']':
+        case ' ': {
+            m_parserStatus = ParserStatus::FinishedValue;
+            FinishNumberValueZero();
+        } break;
+
+        default: {
+            if (IsWhitespace(m_source[m_sourceIndex], true)) {
+                m_parserStatus = ParserStatus::FinishedValue;
+                FinishNumberValueZero();
+            }
+            else {
+                m_parserStatus = ParserStatus::Done;
+                m_errorStatus  = ErrorStatus::ParseError_ExpectedDecimalOrEndOfNumber;
+                NotifyOfError(
+                    "Expected either decimal point, exponent, or end of number, after the leading digit was a zero."
+                );
+            }
+        } break;
+    } // end switch
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNumberValue_ReadingWholeDigits () {
+    std::size_t dataLen = 0;
+    // read number value, while watching for both end of buffer,
+    //   and end of whole digits
+    while (
+        m_sourceIndex + dataLen < m_sourceSize   &&
+        m_source[m_sourceIndex + dataLen] >= '0' &&
+        m_source[m_sourceIndex + dataLen] <= '9'
+    ) {
+        ++dataLen;
+    }
+
+    // hold on to the number's text, and fold the digits into the value as we go
+    AppendToNumberText(m_source + m_sourceIndex, dataLen);
+    if (!m_deferNumbers)
+        m_number.AddDigits(m_source + m_sourceIndex, dataLen, false);
+
+    m_sourceIndex   += dataLen;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNumberValue_ReadingFractionalDigits () {
+    std::size_t dataLen = 0;
+    // read number value, while watching for both end of buffer,
+    //   and end of whole digits
+    while (
+        m_sourceIndex + dataLen < m_sourceSize   &&
+        m_source[m_sourceIndex + dataLen] >= '0' &&
+        m_source[m_sourceIndex + dataLen] <= '9'
+    ) {
+        ++dataLen;
+    }
+
+    // hold on to the number's text, and fold the digits into the value as we go
+    AppendToNumberText(m_source + m_sourceIndex, dataLen);
+    if (!m_deferNumbers)
+        m_number.AddDigits(m_source + m_sourceIndex, dataLen, true);
+
+    m_sourceIndex   += dataLen;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNumberValue_AfterExponentMarker () {
+    const char c = m_source[m_sourceIndex];
+    if (c >= '0' && c <= '9') {
+        m_parserStatus = ParserStatus::NumberReadingExponentDigits;
+        ContinueNumberValue_ReadingExponentDigits();
+    }
+    // one optional sign, right after the 'e'
+    else if ((c == '-' || c == '+') && m_parserStatus == ParserStatus::NumberSawExponentMarker) {
+        m_parserStatus = ParserStatus::NumberSawExponentSign;
+        m_number.explicitExponentNegative = (c == '-');
+        AppendToNumberText(m_source + m_sourceIndex, 1);
+        ++m_sourceIndex;
+    }
+    else {
+        m_parserStatus = ParserStatus::Done;
+        m_errorStatus  = ErrorStatus::ParseError_UnfinishedExponent;
+        NotifyOfError(
+            "Exponents must have digits after the 'e', and after the sign if there is one.  "
+                "So \"1e5\" and \"1e-5\" are valid, but \"1e\" and \"1e+\" are not."
+        );
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNumberValue_ReadingExponentDigits () {
+    std::size_t dataLen = 0;
+    while (
+        m_sourceIndex + dataLen < m_sourceSize   &&
+        m_source[m_sourceIndex + dataLen] >= '0' &&
+        m_source[m_sourceIndex + dataLen] <= '9'
+    ) {
+        ++dataLen;
+    }
+
+    AppendToNumberText(m_source + m_sourceIndex, dataLen);
+    if (!m_deferNumbers)
+        m_number.AddExponentDigits(m_source + m_sourceIndex, dataLen);
+
+    m_sourceIndex   += dataLen;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishNumberValueZero () {
+    /*
+    // we've already read "true", now check that the character immediately after
+    //   it is valid (ie. whitespace, name-value separator, etc.)  As opposed
+    //   to being a second 'e' character, a number, or anything like that.
+    if (
+        !IsWhitespace(m_source[m_sourceIndex], true) &&
+        m_source[m_sourceIndex] != '}'               &&
+        m_source[m_sourceIndex] != ']'               &&
+        m_source[m_sourceIndex] != ','
+    ) {
+        m_errorStatus  = ErrorStatus::ParseError_BadValue;
+        m_parserStatus = ParserStatus::Done;
+        NotifyOfError("Typo found after reading \"true\" value.");
+        return;
+    }
+    //*/
+
+    m_parserStatus = ParserStatus::FinishedValue;
+    if (m_deferNumbers)
+        m_dataCallback->GotNumberRaw(
+            CurrentName(), m_tempNameIndex, NumberText(), NumberTextLength(), NumberKind::Integer
+        );
+    else
+        m_dataCallback->GotInteger(CurrentName(), m_tempNameIndex, 0);
+    m_numberSpan = nullptr;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishNumberValueIntegral () {
+    m_parserStatus = ParserStatus::FinishedValue;
+    if (m_deferNumbers)
+        m_dataCallback->GotNumberRaw(
+            CurrentName(), m_tempNameIndex, NumberText(), NumberTextLength(), NumberKind::Integer
+        );
+    else
+        DeliverNumber(
+            m_dataCallback, CurrentName(), m_tempNameIndex,
+            m_number, NumberText(), NumberTextLength(), NumberKind::Integer
+        );
+    m_numberSpan = nullptr;
+}
+
+//=========================================================================
+// Also finishes numbers with exponents, whether or not they had a fractional
+//   part.
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishNumberValueWithFractional () {
+    m_parserStatus = ParserStatus::FinishedValue;
+    if (m_deferNumbers)
+        m_dataCallback->GotNumberRaw(
+            CurrentName(), m_tempNameIndex, NumberText(), NumberTextLength(), NumberKind::Real
+        );
+    else
+        DeliverNumber(
+            m_dataCallback, CurrentName(), m_tempNameIndex,
+            m_number, NumberText(), NumberTextLength(), NumberKind::Real
+        );
+    m_numberSpan = nullptr;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginTrueValue () {
+    // update internal status
+    m_parserStatus = ParserStatus::ReadingTrueValue;
+    // temp data index will be used to point into our static 'true' array, to
+    //   track which character we need next
+    m_tempDataIndex = 1;
+    // skip the first character, which the caller already matched.  We'll
+    //   walk m_sourceIndex along in ContinueTrueValue as we see more character
+    //   matches for the 'true' keyword; possibly over several buffers.
+    ++m_sourceIndex;
+    ContinueTrueValue();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueTrueValue () {
+    static const char true_value[] = "true";
+
+    // read true value, while watching for both end of buffer,
+    //   and end of 'true' string
+    while (m_sourceIndex < m_sourceSize && m_tempDataIndex < 4) {
+        // check if the given characters match the 'true' keyword
+        if (m_source[m_sourceIndex] != true_value[m_tempDataIndex]) {
+            m_parserStatus = ParserStatus::Done;
+            m_errorStatus  = ErrorStatus::ParseError_ExpectedContinuationOfTrueKeyword;
+            NotifyOfError("Misspelled \"true\" keyword.");
+            return;
+        }
+
+        ++m_tempDataIndex;
+        ++m_sourceIndex;
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishTrueValue () {
+    // we've already read "true", now check that the character immediately after
+    //   it is valid (ie. whitespace, name-value separator, etc.)  As opposed
+    //   to being a second 'e' character, a number, or anything like that.
+    if (!IsWhitespace(m_source[m_sourceIndex], true) &&
+        m_source[m_sourceIndex] != '}'               &&
+        m_source[m_sourceIndex] != ']'               &&
+        m_source[m_sourceIndex] != ','
+    ) {
+        m_errorStatus  = ErrorStatus::ParseError_BadValue;
+        m_parserStatus = ParserStatus::Done;
+        NotifyOfError("Typo found after reading \"true\" value.");
+        return;
+    }
+
+    m_parserStatus = ParserStatus::FinishedValue;
+    m_dataCallback->GotBoolean(CurrentName(), m_tempNameIndex, true);
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginFalseValue () {
+    // update internal status
+    m_parserStatus = ParserStatus::ReadingFalseValue;
+    // temp data index will be used to point into our static 'false' array, to
+    //   track which character we need next
+    m_tempDataIndex = 1;
+    // skip the first character, which the caller already matched.  We'll
+    //   walk m_sourceIndex along in ContinueFalseValue as we see more character
+    //   matches for the 'false' keyword; possibly over several buffers.
+    ++m_sourceIndex;
+    ContinueFalseValue();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueFalseValue () {
+    static const char false_value[] = "false";
+
+    // read false value, while watching for both end of buffer,
+    //   and end of 'false' string
+    while (m_sourceIndex < m_sourceSize && m_tempDataIndex < 5) {
+        // check if the given characters match the 'false' keyword
+        if (m_source[m_sourceIndex] != false_value[m_tempDataIndex]) {
+            m_parserStatus = ParserStatus::Done;
+            m_errorStatus  = ErrorStatus::ParseError_ExpectedContinuationOfFalseKeyword;
+            NotifyOfError("Misspelled \"false\" keyword.");
+            return;
+        }
+
+        ++m_tempDataIndex;
+        ++m_sourceIndex;
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishFalseValue () {
+    // we've already read "false", now check that the character immediately after
+    //   it is valid (ie. whitespace, name-value separator, etc.)  As opposed
+    //   to being a second 'e' character, a number, or anything like that.
+    if (!IsWhitespace(m_source[m_sourceIndex], true) &&
+        m_source[m_sourceIndex] != '}'               &&
+        m_source[m_sourceIndex] != ']'               &&
+        m_source[m_sourceIndex] != ','
+    ) {
+        m_errorStatus  = ErrorStatus::ParseError_BadValue;
+        m_parserStatus = ParserStatus::Done;
+        NotifyOfError("Typo found after reading \"false\" value.");
+        return;
+    }
+
+    m_parserStatus = ParserStatus::FinishedValue;
+    m_dataCallback->GotBoolean(CurrentName(), m_tempNameIndex, false);
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::BeginNullValue () {
+    // update internal status
+    m_parserStatus = ParserStatus::ReadingNullValue;
+    // temp data index will be used to point into our static 'null' array, to
+    //   track which character we need next
+    m_tempDataIndex = 1;
+    // skip the first character, which the caller already matched.  We'll
+    //   walk m_sourceIndex along in ContinueNullValue as we see more character
+    //   matches for the 'null' keyword; possibly over several buffers.
+    ++m_sourceIndex;
+    ContinueNullValue();
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueNullValue () {
+    static const char null_value[] = "null";
+
+    // read null value, while watching for both end of buffer,
+    //   and end of 'null' string
+    while (m_sourceIndex < m_sourceSize && m_tempDataIndex < 4) {
+        // check if the given characters match the 'null' keyword
+        if (m_source[m_sourceIndex] != null_value[m_tempDataIndex]) {
+            m_parserStatus = ParserStatus::Done;
+            m_errorStatus  = ErrorStatus::ParseError_ExpectedContinuationOfNullKeyword;
+            NotifyOfError("Misspelled \"null\" keyword.");
+            return;
+        }
+
+        ++m_tempDataIndex;
+        ++m_sourceIndex;
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::FinishNullValue () {
+    // we've already read "null", now check that the character immediately after
+    //   it is valid (ie. whitespace, name-value separator, etc.)  As opposed
+    //   to being a third 'l' character, a number, or anything like that.
+    if (!IsWhitespace(m_source[m_sourceIndex], true) &&
+        m_source[m_sourceIndex] != '}'               &&
+        m_source[m_sourceIndex] != ']'               &&
+        m_source[m_sourceIndex] != ','
+    ) {
+        m_errorStatus  = ErrorStatus::ParseError_BadValue;
+        m_parserStatus = ParserStatus::Done;
+        NotifyOfError("Typo found after reading \"null\" value.");
+        return;
+    }
+
+    m_parserStatus = ParserStatus::FinishedValue;
+    m_dataCallback->GotNull(CurrentName(), m_tempNameIndex);
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SkipContainer () {
+    if (m_objectTypeStack.Empty() || m_parserStatus >= ParserStatus::Done)
+        return;
+
+    m_parserStatus = ParserStatus::SkippingContainer;
+    m_skipDepth    = 0;
+    m_skipInString = false;
+    m_skipEscaped  = false;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueSkippingContainer () {
+    while (m_sourceIndex < m_sourceSize) {
+        const char c = m_source[m_sourceIndex];
+        if (m_skipInString) {
+            if (m_skipEscaped)
+                m_skipEscaped = false;
+            else if (c == '\\')
+                m_skipEscaped = true;
+            else if (c == '"')
+                m_skipInString = false;
+        }
+        else if (c == '"')
+            m_skipInString = true;
+        else if (c == '{' || c == '[')
+            ++m_skipDepth;
+        else if (c == '}' || c == ']') {
+            // the skipped container's own end.  Leave it for
+            //   EndObject()/EndArray(), which check that it's the right kind.
+            if (m_skipDepth == 0) {
+                ClearNameAndDataBuffers();
+                m_parserStatus = ParserStatus::FinishedValue;
+                return;
+            }
+            --m_skipDepth;
+        }
+
+        ++m_sourceIndex;
+    }
+}
+
+//=========================================================================
+template <typename Handler>
+bool BasicJsonParser<Handler>::SkipBadDocument () {
+    if (!m_skipBadDocuments || m_errorStatus < ErrorStatus::ParseError_Unspecified)
+        return false;
+
+    std::size_t row, column;
+    GetPosition(&row, &column);
+    m_dataCallback->SkippedDocument(m_errorStatus, row, column);
+
+    // The error was found on a later line than the document began on, so
+    //   the document was cut short.  If what was found is the start of the
+    //   next one, don't lose it as well.
+    const bool nextDocumentHere =
+        m_lineStart > m_documentOffset  &&
+        m_sourceIndex < m_sourceSize    &&
+        m_source[m_sourceIndex] == '{';
+
+    m_errorStatus          = ErrorStatus::NotFinished;
+    m_parserStatus         = nextDocumentHere ? ParserStatus::NotStarted : ParserStatus::SkippingToNewline;
+    m_objectTypeStack.Clear();
+    m_numberSpan           = nullptr;
+    m_number.Clear();
+    ClearNameAndDataBuffers();
+    return true;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ContinueSkippingToNewline () {
+    const void * newline = std::memchr(m_source + m_sourceIndex, '\n', m_sourceSize - m_sourceIndex);
+    if (newline == nullptr) {
+        m_sourceIndex = m_sourceSize;
+        return;
+    }
+
+    m_sourceIndex  = static_cast<const char *>(newline) - m_source + 1;
+    m_parserStatus = ParserStatus::NotStarted;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::SetMultipleDocuments (bool enabled, bool skipBadDocuments) {
+    m_multipleDocuments = enabled;
+    m_skipBadDocuments  = enabled && skipBadDocuments;
+}
+
+//=========================================================================
+template <typename Handler>
+void BasicJsonParser<Handler>::ClearNameAndDataBuffers () {
+    m_tempName.Data()[0] = '\0';
+    m_tempNameIndex = 0;
+    m_nameSpan      = nullptr;
+    m_tempData.Data()[0] = '\0';
+    m_tempDataIndex = 0;
+}
+
+#ifdef _MSC_VER
+#	pragma warning(pop)
+#endif
+
+} // namespace CSaruJson
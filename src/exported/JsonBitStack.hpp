@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CSaruJson {
+
+// A stack of bools, one bit each.  The first 64 live inside the object, so
+//   typical documents never allocate; deeper ones spill to heap words that
+//   are kept across Clear()s, like JsonScratchBuffer.
+class JsonBitStack {
+private:
+    // Data
+    // entry i is bit i
+    std::uint64_t   m_inline;
+    // entry 64 + i is bit i % 64 of word i / 64
+    std::uint64_t * m_spill;
+    std::size_t     m_spillWords;
+    std::size_t     m_size;
+
+public:
+    // Methods
+    JsonBitStack ();
+    ~JsonBitStack ();
+
+    inline void Push (bool value) {
+        if (m_size < 64)
+            m_inline = SetBit(m_inline, m_size, value);
+        else
+            PushSpilled(value);
+        ++m_size;
+    }
+
+    // PRE: !Empty()
+    inline void Pop ()                  { --m_size; }
+
+    // PRE: !Empty()
+    inline bool Top () const {
+        const std::size_t index = m_size - 1;
+        if (index < 64)
+            return (m_inline >> index) & 1;
+        return (m_spill[(index - 64) / 64] >> ((index - 64) % 64)) & 1;
+    }
+
+    inline std::size_t Size () const    { return m_size; }
+    inline bool        Empty () const   { return m_size == 0; }
+    inline void        Clear ()         { m_size = 0; }
+
+    JsonBitStack (const JsonBitStack &) = delete;
+    JsonBitStack & operator= (const JsonBitStack &) = delete;
+
+private:
+    // Helpers
+    static inline std::uint64_t SetBit (std::uint64_t word, std::size_t bit, bool value) {
+        const std::uint64_t mask = std::uint64_t(1) << bit;
+        return value ? (word | mask) : (word & ~mask);
+    }
+
+    void PushSpilled (bool value);
+};
+
+} // namespace CSaruJson
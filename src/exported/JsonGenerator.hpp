@@ -22,23 +22,55 @@ freely, subject to the following restrictions:
 
 // std::FILE
 #include <cstdio>
+#include <string>
 
 #include <csaru-datamap-cpp/csaru-datamap-cpp.hpp>
 
+#include "JsonOutput.hpp"
+
 namespace CSaruJson {
 
 class JsonGenerator {
+public:
+    // Types
+    typedef JsonFormat Format;
+
 private:
     // Helpers
-    static bool WriteIndent (std::FILE * file, int indentAmount);
-    static bool WriteJsonToFile (std::FILE * file, CSaruDataMap::DataMapReader * reader, bool currentNodeWritesName);
-    static void WriteEscapedStringToFile (std::FILE * file, const char * string);
+    static bool WriteIndent (JsonOutput * output, int depth, const Format & format);
+    static bool WriteJson (JsonOutput * output, CSaruDataMap::DataMapReader * reader, const Format & format);
+    static void WriteEscapedString (JsonOutput * output, const char * string);
 
 public:
     // Methods
     // reader is assumed to be valid, and *WILL * be modified
-    static bool WriteToFile (CSaruDataMap::DataMapReader * reader, char const * filename);
-    static bool WriteToStream (CSaruDataMap::DataMapReader * reader, std::FILE * file);
+    static bool WriteToFile (
+        CSaruDataMap::DataMapReader * reader,
+        char const *                  filename,
+        const Format &                format = Format()
+    );
+    static bool WriteToStream (
+        CSaruDataMap::DataMapReader * reader,
+        std::FILE *                   file,
+        const Format &                format = Format()
+    );
+    // Writes to any sink, flushing it at the end.
+    static bool WriteToOutput (
+        CSaruDataMap::DataMapReader * reader,
+        JsonOutput *                  output,
+        const Format &                format = Format()
+    );
+    // Appends to str.  With exactSize, the data is walked twice: once to
+    //   count the output and once to write it, straight into the string
+    //   after a single allocation.  Otherwise the string grows as it goes.
+    static bool WriteToString (
+        CSaruDataMap::DataMapReader * reader,
+        std::string *                 str,
+        bool                          exactSize = false,
+        const Format &                format    = Format()
+    );
+    // Number of bytes the other Write functions would produce.
+    static std::size_t ComputeSize (CSaruDataMap::DataMapReader * reader, const Format & format = Format());
 
     DISALLOW_COPY_AND_ASSIGN(JsonGenerator)
     JsonGenerator () = delete;
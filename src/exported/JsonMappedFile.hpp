@@ -0,0 +1,56 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace CSaruJson {
+
+// A whole file, mapped read-only into memory.  Pages are read in as they're
+//   first touched, with the OS told to expect a front-to-back pass so it
+//   reads ahead and drops pages behind.
+// The file mustn't be truncated while it's mapped.
+class JsonMappedFile {
+private:
+    // Data
+    const char * m_data;
+    std::size_t  m_size;
+
+public:
+    // Methods
+    JsonMappedFile ();
+    ~JsonMappedFile ();
+
+    // Maps the file at path, replacing any file already mapped.
+    // RETURN: false if the file couldn't be opened, isn't a regular file
+    //   (pipes and devices can't be mapped), is empty, or doesn't fit in the
+    //   address space.  Read it some other way then.
+    bool Open (const char * path);
+    void Close ();
+
+    inline const char * Data () const { return m_data; }
+    inline std::size_t  Size () const { return m_size; }
+
+    JsonMappedFile (const JsonMappedFile &) = delete;
+    JsonMappedFile & operator= (const JsonMappedFile &) = delete;
+};
+
+} // namespace CSaruJson
@@ -0,0 +1,164 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CSaruJson {
+
+// A decimal number, accumulated digit run by digit run while it's being
+//   scanned (possibly across several buffers).  Only the first
+//   s_maxSignificantDigits significant digits are kept; the rest only move the
+//   exponent, and mark the number as truncated if any of them weren't zero.
+struct JsonDecimal {
+    // Types and Constants
+    // Most significant digits a 64-bit significand can always hold.
+    static const int s_maxSignificantDigits = 19;
+    // Explicit exponents saturate here; far beyond any double's range.
+    static const int s_maxExplicitExponent  = 100000;
+
+    // Data
+    std::uint64_t significand;
+    int           significantDigits;
+    // decimal exponent from fractional (or dropped whole) digits
+    int           exponent;
+    // the value after 'e' or 'E'
+    int           explicitExponent;
+    bool          negative;
+    bool          explicitExponentNegative;
+    // dropped a non-zero digit past s_maxSignificantDigits
+    bool          truncated;
+
+    // Methods
+    inline void Clear () {
+        significand              = 0;
+        significantDigits        = 0;
+        exponent                 = 0;
+        explicitExponent         = 0;
+        negative                 = false;
+        explicitExponentNegative = false;
+        truncated                = false;
+    }
+
+    inline void AddDigits (const char * digits, std::size_t count, bool fractional) {
+        for (std::size_t i = 0;  i < count;  ++i) {
+            const unsigned digit = static_cast<unsigned>(digits[i] - '0');
+            if (significantDigits < s_maxSignificantDigits) {
+                significand = significand * 10 + digit;
+                // leading zeros aren't significant
+                if (significand)
+                    ++significantDigits;
+                if (fractional)
+                    --exponent;
+            }
+            else {
+                truncated |= (digit != 0);
+                if (!fractional)
+                    ++exponent;
+            }
+        }
+    }
+
+    inline void AddExponentDigits (const char * digits, std::size_t count) {
+        for (std::size_t i = 0;  i < count;  ++i) {
+            if (explicitExponent < s_maxExplicitExponent)
+                explicitExponent = explicitExponent * 10 + (digits[i] - '0');
+        }
+    }
+
+    // RETURN: The power of ten the significand is scaled by.
+    inline int Exponent10 () const {
+        return exponent + (explicitExponentNegative ? -explicitExponent : explicitExponent);
+    }
+};
+
+// Locale-independent conversion between JSON number text and binary values.
+//   Decimal-to-binary conversion is correctly rounded: the Eisel-Lemire
+//   algorithm handles everything that fits in 19 significant digits, and a
+//   "C"-locale strtod() the rare number that doesn't.  Binary-to-decimal
+//   conversion round-trips exactly, and is almost always the shortest form
+//   (Grisu2); don't rely on it being the shortest.
+class JsonNumbers {
+public:
+    // Types and Constants
+    // Buffer sizes the *ToText() functions need.  They write no NUL.
+    static const std::size_t s_maxDoubleText = 32;
+    static const std::size_t s_maxFloatText  = 32;
+    static const std::size_t s_maxIntText    = 20;
+
+    // Methods
+    // RETURN: The value nearest to (negative ? -1 : 1) * significand * 10^exponent10.
+    //   significand must have no more than JsonDecimal::s_maxSignificantDigits
+    //   digits.
+    static double DecimalToDouble (std::uint64_t significand, int exponent10, bool negative);
+    static float  DecimalToFloat (std::uint64_t significand, int exponent10, bool negative);
+
+    // Convert an accumulated number.  text is the number's full text; it is
+    //   only looked at if decimal was truncated, and needn't be NUL-terminated.
+    static double ToDouble (const JsonDecimal & decimal, const char * text, std::size_t length);
+    static float  ToFloat (const JsonDecimal & decimal, const char * text, std::size_t length);
+
+    // Get the magnitude of a whole number: one with no fraction or exponent.
+    //   text is as for ToDouble().
+    // RETURN: false if the magnitude doesn't fit 64 bits.
+    static bool WholeToUInt64 (
+        const JsonDecimal & decimal,
+        const char *        text,
+        std::size_t         length,
+        std::uint64_t *     magnitude
+    );
+
+    // Scan the text of a JSON number ("-12.5e3") into decimal.  The text
+    //   doesn't need to be NUL-terminated.
+    // RETURN: false if text isn't exactly one valid JSON number.
+    static bool Scan (const char * text, std::size_t length, JsonDecimal * decimal);
+
+    // Convert the text of a JSON number.
+    // RETURN: false if text isn't a valid JSON number; result is untouched.
+    static bool ParseDouble (const char * text, std::size_t length, double * result);
+    static bool ParseFloat (const char * text, std::size_t length, float * result);
+
+    // Convert the text of a JSON whole number ("-42"; no fraction or
+    //   exponent).
+    // RETURN: false if text isn't a valid whole number, or is out of range
+    //   for the result type; result is untouched.
+    static bool ParseInt64 (const char * text, std::size_t length, std::int64_t * result);
+    static bool ParseUInt64 (const char * text, std::size_t length, std::uint64_t * result);
+
+    // Write value as a JSON number that reads back as exactly the same
+    //   value ("0.1", "1e-9", "-2.5e300").  Almost always the shortest
+    //   such text, but a digit longer for a few values (1e23 is written
+    //   "9.999999999999999e22").  Whole values get a ".0" (or an
+    //   exponent), so they read back as floating point.  JSON
+    //   has no infinities or NaNs; those are written as null.
+    // RETURN: The length written, at most s_maxDoubleText / s_maxFloatText.
+    static std::size_t DoubleToText (double value, char * buffer);
+    static std::size_t FloatToText (float value, char * buffer);
+
+    // RETURN: The length written, at most s_maxIntText.
+    static std::size_t Int64ToText (std::int64_t value, char * buffer);
+    static std::size_t UInt64ToText (std::uint64_t value, char * buffer);
+
+    JsonNumbers () = delete;
+};
+
+} // namespace CSaruJson
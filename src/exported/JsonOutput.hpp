@@ -0,0 +1,285 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace CSaruJson {
+
+// How JsonGenerator and JsonWriter lay out their output.  The default is
+//   what the generator has always written: every element on its own line,
+//   two spaces of indent per level, and a space after each name's colon.
+struct JsonFormat {
+    // No whitespace at all, for the wire and caches.  Overrides the indent
+    //   settings.
+    bool compact;
+    // Indent characters per level; 0 keeps the line breaks but drops the
+    //   indent.
+    int  indentWidth;
+    // ' ' or '\t'.
+    char indentChar;
+
+    JsonFormat () : compact(false), indentWidth(2), indentChar(' ') {}
+
+    static JsonFormat Compact () {
+        JsonFormat format;
+        format.compact = true;
+        return format;
+    }
+
+    static JsonFormat Pretty (int indentWidth, char indentChar = ' ') {
+        JsonFormat format;
+        format.indentWidth = indentWidth;
+        format.indentChar  = indentChar;
+        return format;
+    }
+};
+
+// Where generated JSON goes.  Writes land in a window of memory and are only
+//   handed on once the window fills, so a token costs a memcpy rather than a
+//   libc call.  Derived classes decide what the window is and what happens
+//   when it fills: a fixed buffer drained to a FILE * or file descriptor, or
+//   the tail of a growing std::string / std::vector.
+// Call Flush() when done; nothing is guaranteed to have reached the
+//   destination before that.
+class JsonOutput {
+protected:
+    // Data
+    char * m_begin;
+    char * m_cursor;
+    char * m_end;
+    bool   m_failed;
+
+    // Helpers
+    // Called when fewer than `needed` bytes are left in the window.  Hands
+    //   the written part of the window on, and points the window somewhere
+    //   with room.  Room for less than `needed` is fine, as long as there's at
+    //   least a byte; the rest of a large write just comes back round.  On
+    //   failure set m_failed and leave a window that later writes can be
+    //   dropped into harmlessly.
+    virtual void Overflow (std::size_t needed) = 0;
+
+    void WriteSlow (const char * data, std::size_t size);
+    void WriteRepeatedSlow (char c, std::size_t count);
+
+    // RETURN: The cursor, if there's room for size bytes after it to format
+    //   into in place; otherwise nullptr, and the text should go through
+    //   Write().  Doesn't Overflow(), since the text may turn out shorter.
+    inline char * Room (std::size_t size) {
+        return std::size_t(m_end - m_cursor) >= size ? m_cursor : nullptr;
+    }
+
+public:
+    // Methods
+    JsonOutput ();
+    virtual ~JsonOutput ();
+
+    inline void Put (char c) {
+        if (m_cursor == m_end)
+            Overflow(1);
+        *m_cursor++ = c;
+    }
+
+    inline void Write (const char * data, std::size_t size) {
+        if (std::size_t(m_end - m_cursor) >= size) {
+            memcpy(m_cursor, data, size);
+            m_cursor += size;
+        }
+        else {
+            WriteSlow(data, size);
+        }
+    }
+
+    // NUL terminated.
+    inline void Write (const char * string) {
+        Write(string, strlen(string));
+    }
+
+    // Writes the characters of a JSON string, without its quotes: '"', '\\'
+    //   and control characters are escaped, everything else (UTF-8
+    //   included) is copied as it is.
+    void WriteEscaped (const char * string, std::size_t length);
+
+    // Numbers, formatted straight into the output (see JsonNumbers).
+    void WriteDouble (double value);
+    void WriteFloat (float value);
+    void WriteInt64 (std::int64_t value);
+    void WriteUInt64 (std::uint64_t value);
+
+    inline void WriteRepeated (char c, std::size_t count) {
+        if (std::size_t(m_end - m_cursor) >= count) {
+            memset(m_cursor, c, count);
+            m_cursor += count;
+        }
+        else {
+            WriteRepeatedSlow(c, count);
+        }
+    }
+
+    // Hands everything written so far on to the destination.
+    // RETURN: false if any write has failed since construction.
+    virtual bool Flush ();
+
+    inline bool HadError () const { return m_failed; }
+
+    JsonOutput (const JsonOutput &) = delete;
+    JsonOutput & operator= (const JsonOutput &) = delete;
+};
+
+// Buffers output for a FILE * the caller opened.  Flush() passes the
+//   buffered bytes to fwrite(); the FILE's own buffering and fflush() are
+//   left to the caller, as is closing it.
+class JsonFileOutput : public JsonOutput {
+private:
+    // Data
+    std::FILE *       m_file;
+    std::vector<char> m_buffer;
+
+    // Helpers
+    void Overflow (std::size_t needed) override;
+
+public:
+    // Methods
+    static const std::size_t s_defaultBufferSize = 64 * 1024;
+
+    explicit JsonFileOutput (std::FILE * file, std::size_t bufferSize = s_defaultBufferSize);
+    ~JsonFileOutput ();
+
+    bool Flush () override;
+};
+
+// Buffers output for a raw file descriptor (a socket, pipe or open()ed file)
+//   and write()s it out, without going through stdio at all.  The descriptor
+//   isn't closed.
+class JsonFdOutput : public JsonOutput {
+private:
+    // Data
+    int               m_fd;
+    std::vector<char> m_buffer;
+
+    // Helpers
+    void Overflow (std::size_t needed) override;
+
+public:
+    // Methods
+    static const std::size_t s_defaultBufferSize = 64 * 1024;
+
+    explicit JsonFdOutput (int fd, std::size_t bufferSize = s_defaultBufferSize);
+    ~JsonFdOutput ();
+
+    bool Flush () override;
+};
+
+// Appends to a std::string or std::vector<char>, writing straight into its
+//   storage.  The container is grown geometrically ahead of the writes, so
+//   until Flush() (or destruction) it has unwritten bytes on the end.
+template <typename Container>
+class JsonMemoryOutput : public JsonOutput {
+private:
+    // Data
+    Container * m_container;
+    // where the cursors point once Flush() leaves the container empty, so a
+    //   zero-sized write never copies to or from null
+    char        m_emptyWindow;
+
+    // Helpers
+    void Overflow (std::size_t needed) override {
+        const std::size_t used     = m_container->size() - std::size_t(m_end - m_cursor);
+        std::size_t       required = used + needed;
+        std::size_t       newSize  = m_container->size() * 2;
+        if (newSize < required)
+            newSize = required;
+        if (newSize < 256)
+            newSize = 256;
+
+        m_container->resize(newSize);
+        m_begin  = &(*m_container)[0];
+        m_cursor = m_begin + used;
+        m_end    = m_begin + newSize;
+    }
+
+public:
+    // Methods
+    explicit JsonMemoryOutput (Container * container)
+        : m_container(container)
+    {
+        Overflow(0);
+    }
+
+    ~JsonMemoryOutput () {
+        Flush();
+    }
+
+    // Trims the container down to what has been written.
+    bool Flush () override {
+        const std::size_t used = std::size_t(m_cursor - m_begin);
+        m_container->resize(used);
+        m_begin  = used ? &(*m_container)[0] : &m_emptyWindow;
+        m_cursor = m_end = m_begin + used;
+        return !m_failed;
+    }
+};
+
+typedef JsonMemoryOutput<std::string>       JsonStringOutput;
+typedef JsonMemoryOutput<std::vector<char>> JsonVectorOutput;
+
+// Writes into caller-provided memory of fixed size.  Running out of room is
+//   an error; everything past the end is dropped.  Paired with
+//   JsonCountingOutput this gives two-pass output into a single, exactly
+//   sized allocation.
+class JsonSpanOutput : public JsonOutput {
+private:
+    // Data
+    char m_overflow[64];
+
+    // Helpers
+    void Overflow (std::size_t needed) override;
+
+public:
+    // Methods
+    JsonSpanOutput (char * buffer, std::size_t capacity);
+
+    inline std::size_t Size () const { return m_failed ? 0 : std::size_t(m_cursor - m_begin); }
+};
+
+// Writes nothing, only counts.  The first pass of two-pass output.
+class JsonCountingOutput : public JsonOutput {
+private:
+    // Data
+    char        m_scratch[1024];
+    std::size_t m_count;
+
+    // Helpers
+    void Overflow (std::size_t needed) override;
+
+public:
+    // Methods
+    JsonCountingOutput ();
+
+    inline std::size_t Count () const { return m_count + std::size_t(m_cursor - m_begin); }
+};
+
+} // namespace CSaruJson
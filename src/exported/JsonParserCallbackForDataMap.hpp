@@ -30,6 +30,9 @@ class JsonParserCallbackForDataMap : public JsonParser::CallbackInterface {
 private:
     // Data
     CSaruDataMap::DataMapMutator m_mutator;
+    // the container just begun is known to be empty, so it was given no
+    //   write-location child for its end to clean up
+    bool                         m_beganEmpty;
 
 public:
     // Methods
@@ -43,6 +46,10 @@ public:
     virtual void EndObject (void);
     virtual void BeginArray (const char * name, size_t nameLen);
     virtual void EndArray (void);
+    // Only size 0 is used (see SetContainerSizes()); DataMap can't reserve
+    //   children for the rest.
+    virtual void BeginObjectSized (const char * name, size_t nameLen, size_t size);
+    virtual void BeginArraySized (const char * name, size_t nameLen, size_t size);
     virtual void GotString (const char * name, size_t nameLen, const char * value, size_t valueLen);
     virtual void GotFloat (const char * name, size_t nameLen, float value);
     virtual void GotInteger (const char * name, size_t nameLen, int value);
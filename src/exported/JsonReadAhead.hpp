@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CSaruJson {
+
+// Reads a file on a background thread, into a ring of buffers, so the next
+//   chunks are already on their way while the current one is parsed.
+//
+//   JsonReadAhead readAhead(file, 1 << 20, 3);
+//   while (readAhead.Acquire(&chunk, &chunkSize)) {
+//       ... use chunk ...
+//       readAhead.Release();
+//   }
+//
+// The file mustn't be touched by anything else until this is destroyed.
+class JsonReadAhead {
+private:
+    // Data
+    std::FILE *              m_file;
+    std::size_t              m_bufferSize;
+    std::vector<char>        m_buffers;     // bufferCount * bufferSize
+    std::vector<std::size_t> m_chunkSizes;  // per buffer
+    std::size_t              m_bufferCount;
+
+    // Chunks are numbered in file order; chunk n goes in buffer
+    //   n % bufferCount.
+    std::size_t m_chunksRead;
+    std::size_t m_chunksAcquired;
+    std::size_t m_chunksReleased;
+
+    bool m_finished;  // the reader thread won't read any more
+    bool m_readError;
+    bool m_stop;      // asked to stop early
+
+    std::mutex              m_mutex;
+    std::condition_variable m_chunkRead;
+    std::condition_variable m_chunkReleased;
+    std::thread             m_thread;
+
+    // Helpers
+    void ReadChunks ();
+
+public:
+    // Methods
+    // bufferCount is at least 2: one being used, one being read.
+    JsonReadAhead (std::FILE * file, std::size_t bufferSize, std::size_t bufferCount);
+    // Stops reading, waiting for a read in progress to finish.
+    ~JsonReadAhead ();
+
+    // Waits for the next chunk of the file.  chunk stays valid until
+    //   Release().  Only one chunk may be held at a time.
+    // RETURN: false at the end of the file, or on a read error.
+    bool Acquire (const char ** chunk, std::size_t * chunkSize);
+    // Hand back the chunk from the last Acquire(), to be read into again.
+    void Release ();
+
+    // RETURN: true if reading stopped because of an error.  Only meaningful
+    //   once Acquire() has returned false.
+    bool HadReadError ();
+
+    JsonReadAhead (const JsonReadAhead &) = delete;
+    JsonReadAhead & operator= (const JsonReadAhead &) = delete;
+};
+
+} // namespace CSaruJson
@@ -0,0 +1,175 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BasicJsonParser.hpp"
+#include "JsonScratchBuffer.hpp"
+
+namespace CSaruJson {
+
+// Pull-style reading: instead of receiving events, ask for the next token.
+//   Input is fed in chunks, like ParseBuffer():
+//
+//   reader.Feed(chunk, chunkSize);
+//   for (JsonReader::Token token = reader.Next(); ...; token = reader.Next()) {
+//       if (token.type == JsonReader::TokenType::NeedMoreInput)
+//           reader.Feed(nextChunk, nextChunkSize);
+//       ...
+//   }
+//
+// Names, strings and numbers are handed over without copying where
+//   possible, and numbers aren't converted until asked (see JsonNumbers).
+class JsonReader {
+public:
+    // Types and Constants
+    enum class TokenType {
+        // The current chunk is used up; Feed() the next one.
+        NeedMoreInput,
+
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        // name of the value that follows it
+        Key,
+        String,
+        Number,
+        Boolean,
+        Null,
+
+        // The root object is closed.
+        EndOfDocument,
+        // See GetErrorCode().
+        Error
+    };
+
+    struct Token {
+        TokenType    type;
+        // Key and String: the unescaped text.  Number: the text as written,
+        //   ready for JsonNumbers::ParseDouble() and friends.  Not
+        //   NUL-terminated.  Only valid until the next call to Next(),
+        //   SkipValue() or Feed(); and only while the chunk it came from is.
+        const char * text;
+        std::size_t  length;
+        // Number only
+        JsonParserBase::NumberKind numberKind;
+        // Boolean only
+        bool         boolean;
+    };
+
+private:
+    // Turns parser events into tokens, pausing the parser after each one.
+    struct Handler : JsonHandlerBase<Handler> {
+        JsonReader * reader;
+
+        void BeginObject (const char * name, std::size_t name_len);
+        void EndObject ();
+        void BeginArray (const char * name, std::size_t name_len);
+        void EndArray ();
+        void GotString (const char * name, std::size_t name_len, const char * value, std::size_t value_len);
+        void GotStringSpan (
+            const char * name,
+            std::size_t  name_len,
+            const char * value,
+            std::size_t  value_len,
+            bool         value_has_escapes
+        );
+        void GotNumberRaw (
+            const char *               name,
+            std::size_t                name_len,
+            const char *               text,
+            std::size_t                text_len,
+            JsonParserBase::NumberKind kind
+        );
+        void GotBoolean (const char * name, std::size_t name_len, bool value);
+        void GotNull (const char * name, std::size_t name_len);
+
+        // never called; numbers are deferred
+        void GotFloat (const char *, std::size_t, float) {}
+        void GotInteger (const char *, std::size_t, int) {}
+    };
+
+    // Data
+    BasicJsonParser<Handler> m_parser;
+    Handler                  m_handler;
+
+    // Tokens from the last event, not yet returned: a Key, then its value.
+    Token       m_pending[4];
+    std::size_t m_pendingCount;
+    std::size_t m_pendingIndex;
+
+    // The chunk being parsed.  Text inside it is handed over as-is.
+    const char * m_chunk;
+    std::size_t  m_chunkSize;
+
+    // Copies of text the parser held in its own buffers, which it clears
+    //   after each event.
+    JsonScratchBuffer m_key;
+    JsonScratchBuffer m_value;
+
+    // true for objects, false for arrays
+    std::vector<bool> m_containers;
+
+    // what SkipValue() acts on
+    TokenType m_lastType;
+
+    // A skipped container's end event is still coming; don't report it.
+    bool m_swallowEnd;
+
+    // Helpers
+    Token & PushValue (
+        TokenType    type,
+        const char * name,
+        std::size_t  nameLen,
+        const char * text,
+        std::size_t  length
+    );
+    void PushEnd (TokenType type);
+    const char * Keep (JsonScratchBuffer * buffer, const char * text, std::size_t length);
+    void SkipOpenContainer ();
+
+public:
+    // Methods
+    JsonReader ();
+
+    // Start over, for a new document.
+    void Reset ();
+
+    // Hand over the next chunk of input.  Call once to start, and again
+    //   whenever Next() returns NeedMoreInput.  buffer must stay valid until
+    //   then.
+    void Feed (const char * buffer, std::size_t bufferSize);
+
+    Token Next ();
+
+    // Skip a value without looking at what's in it.  If the last token was a
+    //   Key, skips its value.  If it was BeginObject or BeginArray, skips the
+    //   rest of that container, including its end token.
+    // RETURN: false if there was nothing to skip.
+    bool SkipValue ();
+
+    inline JsonParserBase::ErrorStatus GetErrorCode () const { return m_parser.GetErrorCode(); }
+};
+
+} // namespace CSaruJson
@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace CSaruJson {
+
+// Growable scratch memory owned by a parser.  Capacity only ever grows, and
+//   is kept across Reset()s, so once a parser has seen its largest token no
+//   further allocations happen.
+class JsonScratchBuffer {
+private:
+    // Data
+    char *      m_data;
+    std::size_t m_capacity;
+
+public:
+    // Methods
+    explicit JsonScratchBuffer (std::size_t initialCapacity);
+    ~JsonScratchBuffer ();
+
+    // Ensure at least `capacity` bytes are usable.  Existing contents are
+    //   preserved.  Grows geometrically to keep appends amortized O(1).
+    inline void Reserve (std::size_t capacity) {
+        if (capacity > m_capacity)
+            Grow(capacity);
+    }
+
+    inline char *       Data ()           { return m_data; }
+    inline const char * Data () const     { return m_data; }
+    inline std::size_t  Capacity () const { return m_capacity; }
+
+    JsonScratchBuffer (const JsonScratchBuffer &) = delete;
+    JsonScratchBuffer & operator= (const JsonScratchBuffer &) = delete;
+
+private:
+    // Helpers
+    void Grow (std::size_t capacity);
+};
+
+} // namespace CSaruJson
@@ -0,0 +1,178 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CSaruJson {
+
+// Per 64-byte block classification of the source.  Bit n of each mask
+//   stands for byte n of the block.
+struct JsonBlockMasks {
+    std::uint64_t quote;      // "
+    std::uint64_t backslash;  // \ (backslash)
+    std::uint64_t structural; // { } [ ] : ,
+    std::uint64_t whitespace; // space, tab, LF, CR
+};
+
+// A container found by JsonStructuralIndex::FindContainerSizes().
+struct JsonContainerSize {
+    std::size_t offset; // of its opening bracket
+    std::size_t size;   // elements (or members), or s_unknownSize
+};
+
+// Pre-scan for the parser: classifies a buffer 64 bytes at a time (using
+//   AVX2 or SSE2 when the CPU has them, plain C++ otherwise) so the parser
+//   can skip past whitespace and string contents instead of testing every
+//   byte.  (FindContainerSizes() is the only user of the structural mask.)  Blocks are classified lazily, a window at a time, so memory
+//   use doesn't depend on the buffer's size.
+// Large buffers can also be classified ahead of time by scan threads, a
+//   segment at a time, into a ring of segments just ahead of the parser.
+//   A block's masks don't depend on anything before it (such as whether
+//   it starts inside a string), so segments are classified independently.
+class JsonStructuralIndex {
+public:
+    // Types and Constants
+    static const std::size_t s_blockSize     = 64;
+    static const std::size_t s_windowBlocks  = 64;
+    static const std::size_t s_segmentBlocks = 4096;
+    static const std::size_t s_segmentSize   = s_segmentBlocks * s_blockSize;
+    // Buffers smaller than this many segments aren't worth the threads.
+    static const std::size_t s_minScanSegments = 4;
+    // A window with a quote or structural character every s_denseSpacing
+    //   bytes or closer (judged from its first s_denseSampleBlocks blocks)
+    //   is dense: its strings and whitespace runs are short enough that the
+    //   parser's byte-by-byte loops beat a call in here, and classifying
+    //   costs more than it saves.  The parser then scans the next
+    //   s_denseStretchWindows windows' worth byte-by-byte, after which the
+    //   next window classified is measured again.
+    static const std::size_t s_denseSpacing        = 8;
+    static const std::size_t s_denseSampleBlocks   = 8;
+    static const std::size_t s_denseStretchWindows = 8;
+
+    typedef void (*ClassifyFunction)(const char * data, std::size_t blockCount, JsonBlockMasks * result);
+
+private:
+    // Data
+    const char * m_source;
+    std::size_t  m_sourceSize;
+
+    // [m_windowBegin, m_windowEnd) of m_source is classified in
+    //   m_windowMasks, which points at m_masks or at a scanned segment.
+    std::size_t            m_windowBegin;
+    std::size_t            m_windowEnd;
+    const JsonBlockMasks * m_windowMasks;
+    JsonBlockMasks         m_masks[s_windowBlocks];
+    // End of the dense stretch the parser is in, if any.  Carries over into
+    //   the next buffer, so small buffers don't each get measured.
+    std::size_t            m_denseEnd;
+
+    // Scan threads.  Segment n goes in m_segments[n % m_segments.size()],
+    //   once the parser has moved past the one that was there.
+    struct Segment {
+        std::size_t                 index;
+        std::size_t                 end;   // of the classified part of m_source
+        bool                        ready;
+        std::vector<JsonBlockMasks> masks;
+    };
+    std::vector<std::thread> m_scanThreads;
+    std::vector<Segment>     m_segments;
+    std::mutex               m_scanMutex;
+    std::condition_variable  m_scanWork;     // for scan threads
+    std::condition_variable  m_segmentDone;  // for the parser
+    bool                     m_scanning;     // the current buffer is being scanned
+    bool                     m_stopScanThreads;
+    std::size_t              m_segmentCount;
+    std::size_t              m_nextSegment;  // to be claimed by a scan thread
+    std::size_t              m_currentSegment;
+    std::size_t              m_scansInFlight;
+
+    // Helpers
+    void IndexWindowAt (std::size_t sourceIndex);
+    // Classify up to blockLimit blocks from begin.
+    // RETURN: End of what was classified.
+    std::size_t ClassifyRange (std::size_t begin, std::size_t blockLimit, JsonBlockMasks * result) const;
+
+    void ScanThread ();
+    void StartScanning ();
+    void StopScanning ();
+    void StopScanThreads ();
+
+    // Walks the blocks from `from` onward, returning the index of the first
+    //   bit set in selector(blockMasks).
+    template <typename MaskSelector>
+    std::size_t FindNext (std::size_t from, MaskSelector selector);
+
+public:
+    // Methods
+    JsonStructuralIndex ();
+    ~JsonStructuralIndex ();
+
+    // Start indexing a new buffer.  Nothing is classified until asked for,
+    //   unless there are scan threads.
+    void Attach (const char * source, std::size_t sourceSize);
+    // Done with the buffer; scan threads stop reading it.
+    void Detach ();
+
+    // RETURN: End of the dense stretch (see s_denseSpacing) the parser is
+    //   in, if any; it should find its own way up to there.
+    inline std::size_t GetDenseEnd () const { return m_denseEnd; }
+
+    // Background threads to classify large buffers ahead of the parser.  0
+    //   for none (the default).
+    void SetScanThreads (std::size_t threadCount);
+
+    // RETURN: Index of the first '"' or '\' at or after from, or the
+    //   buffer's size if there isn't one.
+    std::size_t FindStringStop (std::size_t from);
+
+    // RETURN: Index of the first non-whitespace character at or after from,
+    //   or the buffer's size if there isn't one.
+    std::size_t FindNonWhitespace (std::size_t from);
+
+    // Classify blockCount whole blocks at data, with the best implementation
+    //   the running CPU supports.
+    static void ClassifyBlocks (const char * data, std::size_t blockCount, JsonBlockMasks * result);
+
+    // Name of the implementation ClassifyBlocks() uses ("avx2", "sse2",
+    //   or "scalar").
+    static const char * GetClassifierName ();
+
+    // Container pre-pass.  Walks the structural characters outside strings
+    //   of a whole buffer, which must not begin inside a string, and counts
+    //   the elements of every container in it.  Appends one entry to sizes
+    //   per opening bracket, in order; containers that aren't closed within
+    //   the buffer get s_unknownSize.  Malformed input just ends the pass
+    //   early, leaving the parser to report it.
+    static const std::size_t s_unknownSize = std::size_t(-1);
+    static void FindContainerSizes (
+        const char *                     source,
+        std::size_t                      sourceSize,
+        std::vector<JsonContainerSize> * sizes
+    );
+};
+
+} // namespace CSaruJson
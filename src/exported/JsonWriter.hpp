@@ -0,0 +1,164 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BasicJsonParser.hpp"
+#include "JsonOutput.hpp"
+
+namespace CSaruJson {
+
+// Writes JSON straight to a JsonOutput as it's described, one call per
+//   token, with no tree built first:
+//
+//   writer.BeginObject();
+//   writer.Key("id");    writer.Int(42);
+//   writer.Key("tags");  writer.BeginArray();  writer.String("a");  writer.EndArray();
+//   writer.EndObject();
+//
+// Only a bit per open container is kept.  Calls that would make the
+//   structure invalid (a value in an object with no key, a key in an array,
+//   an EndArray() closing an object, a second root) are refused: the writer
+//   records the error and ignores everything after it.  Check
+//   GetErrorStatus() at the end.
+//
+// It's also a parser callback, so a parser can be piped straight into a
+//   writer to re-encode a document (say, to compact it) without a DataMap
+//   in between.  Names from the parser become keys inside objects and are
+//   dropped elsewhere.  With multiple documents on, each document is written
+//   on a line of its own in compact mode.  A document the parser skips as
+//   malformed can't be taken back: whatever of it was already written is
+//   left unfinished on a line of its own, the writer starts over on the
+//   next document, and GetSkippedDocuments() counts it.
+class JsonWriter : public JsonParserBase::CallbackInterface {
+public:
+    // Types
+    enum class ErrorStatus {
+        None = 0,
+
+        // Key() outside an object, or twice in a row.
+        Error_KeyNotInObject,
+        // A value in an object, without a Key() before it.
+        Error_ExpectedKey,
+        // End*() with nothing open, the wrong kind open, or a key waiting
+        //   for its value.
+        Error_MismatchedEnd,
+        // A value after the root one was finished.
+        Error_SecondRoot,
+        // The output failed to write.
+        Error_OutputFailed
+    };
+
+private:
+    // Data
+    JsonOutput *      m_output;
+    JsonFormat        m_format;
+    // true for each open object, false for each open array
+    std::vector<bool> m_containers;
+    // the innermost container has no elements yet
+    bool              m_first;
+    bool              m_afterKey;
+    bool              m_rootWritten;
+    ErrorStatus       m_errorStatus;
+    std::size_t       m_skippedDocuments;
+    // zero-copy strings with escapes in, unescaped
+    std::vector<char> m_unescaped;
+
+    // Helpers
+    bool BeginValue ();
+    void EndValue ();
+    void BeginElement ();
+    void BeginContainer (bool isObject);
+    void EndContainer (bool isObject);
+    void KeyIfInObject (const char * name, std::size_t nameLen);
+    void WriteLine (std::size_t depth);
+
+public:
+    // Methods
+    explicit JsonWriter (JsonOutput * output, const JsonFormat & format = JsonFormat());
+
+    // Start over on a new document, to the same output.
+    void Reset ();
+
+    // Structure
+    void BeginObject ();
+    void EndObject () override;
+    void BeginArray ();
+    void EndArray () override;
+    void Key (const char * name, std::size_t nameLen);
+    void Key (const char * name);
+
+    // Values
+    void String (const char * value, std::size_t valueLen);
+    void String (const char * value);
+    void Int (std::int64_t value);
+    void UInt (std::uint64_t value);
+    // Round-trips exactly; almost always the shortest form (see JsonNumbers).
+    void Double (double value);
+    void Float (float value);
+    void Bool (bool value);
+    void Null ();
+
+    // RETURN: true once a whole root value has been written, without error.
+    bool IsComplete () const;
+    ErrorStatus GetErrorStatus () const;
+    // RETURN: Documents abandoned through SkippedDocument() since the writer
+    //   was made.  Any of these that were partly written left an unfinished
+    //   line in the output.
+    std::size_t GetSkippedDocuments () const;
+
+    // CallbackInterface implementations
+    void BeginObject (const char * name, std::size_t nameLen) override;
+    void BeginArray (const char * name, std::size_t nameLen) override;
+    void GotString (const char * name, std::size_t nameLen, const char * value, std::size_t valueLen) override;
+    void GotFloat (const char * name, std::size_t nameLen, float value) override;
+    void GotInteger (const char * name, std::size_t nameLen, int value) override;
+    void GotBoolean (const char * name, std::size_t nameLen, bool value) override;
+    void GotNull (const char * name, std::size_t nameLen) override;
+    void GotInt64 (const char * name, std::size_t nameLen, std::int64_t value) override;
+    void GotUInt64 (const char * name, std::size_t nameLen, std::uint64_t value) override;
+    void GotDouble (const char * name, std::size_t nameLen, double value) override;
+    // Deferred numbers are copied exactly as they were written.
+    void GotNumberRaw (
+        const char *               name,
+        std::size_t                nameLen,
+        const char *               text,
+        std::size_t                textLen,
+        JsonParserBase::NumberKind kind
+    ) override;
+    void GotStringSpan (
+        const char * name,
+        std::size_t  nameLen,
+        const char * value,
+        std::size_t  valueLen,
+        bool         valueHasEscapes
+    ) override;
+    void EndDocument () override;
+    void SkippedDocument (JsonParserBase::ErrorStatus error, std::size_t row, std::size_t column) override;
+
+    JsonWriter (const JsonWriter &) = delete;
+    JsonWriter & operator= (const JsonWriter &) = delete;
+};
+
+} // namespace CSaruJson
@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BasicJsonParser.hpp"
+#include "JsonMappedFile.hpp"
+
+namespace CSaruJson {
+
+// Scheduling for ParallelLineParser; everything that doesn't depend on the
+//   handler type.
+class ParallelLineParserBase {
+public:
+    // Types and Constants
+    static const std::size_t s_defaultChunkSize = 4 * 1024 * 1024;
+
+    enum class Order {
+        // EndChunk() is called as each chunk is finished.
+        Unordered,
+        // EndChunk() is called one chunk at a time, in the order the chunks
+        //   appear in the data.
+        Ordered
+    };
+
+protected:
+    struct Chunk {
+        const char * data;
+        std::size_t  size;
+    };
+
+    // A worker's own chunks, in ascending order.  Other workers steal from
+    //   it once theirs run out.
+    struct WorkQueue {
+        std::mutex              mutex;
+        std::deque<std::size_t> chunks;
+    };
+
+    // Data
+    std::size_t m_chunkSize;
+    Order       m_order;
+    bool        m_skipBadDocuments;
+    bool        m_structuralIndexing;
+    bool        m_zeroCopy;
+    bool        m_deferNumbers;
+
+    std::vector<Chunk>                      m_chunks;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+    std::atomic<bool>       m_failed;
+    std::mutex              m_commitMutex;
+    std::condition_variable m_committed;
+    std::size_t             m_nextToCommit;
+    // the first chunk that failed, and why
+    std::size_t                 m_errorChunk;
+    JsonParserBase::ErrorStatus m_errorStatus;
+
+    // Helpers
+    // Split the data into newline-aligned chunks and deal them out.
+    void Prepare (const char * buffer, std::size_t bufferSize, std::size_t workerCount);
+    // RETURN: false when there's nothing left to do.
+    bool TakeChunk (std::size_t worker, std::size_t * chunkIndex);
+    // In Ordered mode, waits until all the chunks before this one have
+    //   ended.
+    // RETURN: false if the parse failed meanwhile.
+    bool WaitForTurn (std::size_t chunkIndex);
+    void EndTurn (std::size_t chunkIndex);
+    void Fail (std::size_t chunkIndex, JsonParserBase::ErrorStatus status);
+
+    ParallelLineParserBase ();
+
+public:
+    // Methods
+    // Roughly how much data each worker takes at a time.  Chunks are
+    //   extended to end at a newline.
+    void SetChunkSize (std::size_t chunkSize);
+    void SetOrder (Order order);
+    // As for BasicJsonParser::SetMultipleDocuments().
+    void SetSkipBadDocuments (bool enabled);
+    // Passed on to every worker's parser.
+    void SetStructuralIndexing (bool enabled);
+    void SetZeroCopy (bool enabled);
+    void SetDeferredNumbers (bool enabled);
+
+    // Why the last Parse() failed, if it did; from the first chunk that did.
+    inline JsonParserBase::ErrorStatus GetErrorCode () const { return m_errorStatus; }
+    inline std::size_t                 GetErrorChunk () const { return m_errorChunk; }
+
+    // One per hardware thread.
+    static std::size_t DefaultWorkerCount ();
+};
+
+// Parses JSON Lines (NDJSON) on several threads at once.  The data is split
+//   into chunks at newlines, and each worker parses whole chunks with its own
+//   parser into its own handler; workers that run out of chunks take some
+//   from the others.
+//
+// Handler is as for BasicJsonParser, and also needs:
+//   void BeginChunk (std::size_t chunkIndex);
+//   void EndChunk (std::size_t chunkIndex);
+// All of a chunk's events arrive on one thread, between its BeginChunk() and
+//   EndChunk().  A handler typically collects a chunk's results in
+//   BeginChunk()...EndChunk() and hands them on in EndChunk(); in Ordered mode
+//   that hand-off happens in the order of the data.  EndChunk() isn't called
+//   for a chunk that failed.
+// Rows and columns in errors (and in SkippedDocument()) count from the
+//   start of the chunk.
+template <typename Handler>
+class ParallelLineParser : public ParallelLineParserBase {
+private:
+    // Data
+    // one per worker, kept between parses
+    std::vector<std::unique_ptr<BasicJsonParser<Handler>>> m_parsers;
+
+    // Helpers
+    void Work (std::size_t worker, Handler * handler);
+
+public:
+    // Methods
+    // handlers [in]: One per worker; workerCount of them.  The calling
+    //   thread is one of the workers.
+    // RETURN: true on success, false on failure.
+    bool Parse (const char * buffer, std::size_t bufferSize, Handler * const * handlers, std::size_t workerCount);
+    // The same, for the file at path.  It's memory-mapped if possible, and
+    //   read into memory whole if not.
+    bool ParseFile (const char * path, Handler * const * handlers, std::size_t workerCount);
+};
+
+//=========================================================================
+template <typename Handler>
+bool ParallelLineParser<Handler>::Parse (
+    const char *        buffer,
+    std::size_t         bufferSize,
+    Handler * const *   handlers,
+    std::size_t         workerCount
+) {
+    if ((buffer == nullptr && bufferSize) || handlers == nullptr || workerCount == 0) {
+        m_errorStatus = JsonParserBase::ErrorStatus::Error_CantAccessData;
+        return false;
+    }
+
+    Prepare(buffer, bufferSize, workerCount);
+
+    while (m_parsers.size() < workerCount)
+        m_parsers.emplace_back(new BasicJsonParser<Handler>());
+    for (std::size_t worker = 0;  worker < workerCount;  ++worker) {
+        BasicJsonParser<Handler> & parser = *m_parsers[worker];
+        parser.SetMultipleDocuments(true, m_skipBadDocuments);
+        parser.SetStructuralIndexing(m_structuralIndexing);
+        parser.SetZeroCopy(m_zeroCopy);
+        parser.SetDeferredNumbers(m_deferNumbers);
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t worker = 1;  worker < workerCount;  ++worker)
+        threads.emplace_back(&ParallelLineParser::Work, this, worker, handlers[worker]);
+    Work(0, handlers[0]);
+    for (std::thread & thread : threads)
+        thread.join();
+
+    return !m_failed;
+}
+
+//=========================================================================
+template <typename Handler>
+bool ParallelLineParser<Handler>::ParseFile (const char * path, Handler * const * handlers, std::size_t workerCount) {
+    if (path == nullptr) {
+        m_errorStatus = JsonParserBase::ErrorStatus::Error_CantAccessData;
+        return false;
+    }
+
+    JsonMappedFile mappedFile;
+    if (mappedFile.Open(path))
+        return Parse(mappedFile.Data(), mappedFile.Size(), handlers, workerCount);
+
+    // can't be mapped (a pipe, say); read it all in
+    std::FILE * file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        m_errorStatus = JsonParserBase::ErrorStatus::Error_CantAccessData;
+        return false;
+    }
+    std::vector<char> data;
+    char              readBuffer[64 * 1024];
+    std::size_t       charsThisRead;
+    while ((charsThisRead = std::fread(readBuffer, sizeof(char), sizeof(readBuffer), file)) != 0)
+        data.insert(data.end(), readBuffer, readBuffer + charsThisRead);
+    const bool readError = std::ferror(file) != 0;
+    std::fclose(file);
+    if (readError) {
+        m_errorStatus = JsonParserBase::ErrorStatus::Error_BadFileRead;
+        return false;
+    }
+
+    return Parse(data.data(), data.size(), handlers, workerCount);
+}
+
+//=========================================================================
+template <typename Handler>
+void ParallelLineParser<Handler>::Work (std::size_t worker, Handler * handler) {
+    BasicJsonParser<Handler> & parser = *m_parsers[worker];
+
+    std::size_t chunkIndex;
+    while (TakeChunk(worker, &chunkIndex)) {
+        const Chunk & chunk = m_chunks[chunkIndex];
+
+        handler->BeginChunk(chunkIndex);
+        parser.Reset();
+        parser.ParseBuffer(chunk.data, chunk.size, handler);
+        if (!parser.FinishData()) {
+            Fail(chunkIndex, parser.GetErrorCode());
+            return;
+        }
+
+        if (!WaitForTurn(chunkIndex))
+            return;
+        handler->EndChunk(chunkIndex);
+        EndTurn(chunkIndex);
+    }
+}
+
+} // namespace CSaruJson
@@ -1,5 +1,13 @@
 #pragma once
 
+#include <csaru-json-cpp/BasicJsonParser.hpp>
 #include <csaru-json-cpp/JsonGenerator.hpp>
+#include <csaru-json-cpp/JsonMappedFile.hpp>
+#include <csaru-json-cpp/JsonNumbers.hpp>
+#include <csaru-json-cpp/JsonOutput.hpp>
 #include <csaru-json-cpp/JsonParser.hpp>
 #include <csaru-json-cpp/JsonParserCallbackForDataMap.hpp>
+#include <csaru-json-cpp/JsonReadAhead.hpp>
+#include <csaru-json-cpp/JsonReader.hpp>
+#include <csaru-json-cpp/JsonWriter.hpp>
+#include <csaru-json-cpp/ParallelLineParser.hpp>
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+// JsonWriter as a parser callback, on JSON Lines with a bad line in it.
+//   Exits non-zero on failure.
+//
+// Build against the library, for example:
+//   g++ -O2 -std=c++11 -I<pkg include dir> JsonWriterTest.cpp
+//     <csaru-json-cpp sources or library> -pthread -o JsonWriterTest
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <csaru-json-cpp/JsonOutput.hpp>
+#include <csaru-json-cpp/JsonParser.hpp>
+#include <csaru-json-cpp/JsonWriter.hpp>
+
+namespace {
+
+int s_failures = 0;
+
+//=========================================================================
+void Check (bool passed, const char * what) {
+    if (!passed) {
+        std::fprintf(stderr, "FAILED: %s\n", what);
+        ++s_failures;
+    }
+}
+
+//=========================================================================
+// RETURN: What the writer made of input, parsed with bad documents skipped.
+std::string Rewrite (const char * input, const CSaruJson::JsonFormat & format, std::size_t * skipped) {
+    std::string output;
+    {
+        CSaruJson::JsonMemoryOutput<std::string> memoryOutput(&output);
+        CSaruJson::JsonWriter                    writer(&memoryOutput, format);
+        CSaruJson::JsonParser                    parser;
+        parser.SetMultipleDocuments(true, true);
+        parser.ParseBuffer(input, std::strlen(input), &writer);
+        parser.FinishData();
+
+        Check(writer.GetErrorStatus() == CSaruJson::JsonWriter::ErrorStatus::None, "no writer error");
+        *skipped = writer.GetSkippedDocuments();
+    }
+    return output;
+}
+
+//=========================================================================
+// A bad line with containers open doesn't swallow the documents after it.
+void TestSkippedDocument () {
+    const char * input   = "{\"a\":1}\n{\"a\":[1,,2]}\n{\"b\":2}\n";
+    std::size_t  skipped = 0;
+
+    const std::string compact = Rewrite(input, CSaruJson::JsonFormat::Compact(), &skipped);
+    Check(compact == "{\"a\":1}\n{\"a\":[1\n{\"b\":2}\n", "compact: bad line left unfinished on its own");
+    Check(skipped == 1, "compact: one document skipped");
+
+    const std::string pretty = Rewrite(input, CSaruJson::JsonFormat::Pretty(2), &skipped);
+    Check(
+        pretty == "{\n  \"a\": 1\n}\n{\n  \"a\": [\n    1\n{\n  \"b\": 2\n}\n",
+        "pretty: next document starts afresh"
+    );
+    Check(skipped == 1, "pretty: one document skipped");
+}
+
+} // namespace
+
+//=========================================================================
+int main () {
+    TestSkippedDocument();
+
+    if (s_failures == 0)
+        std::printf("JsonWriterTest: all passed\n");
+    return s_failures == 0 ? 0 : 1;
+}
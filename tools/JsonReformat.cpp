@@ -0,0 +1,384 @@
+/*
+Copyright (c) 2016 Christopher Higgins Barrett
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgement in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+// json-reformat: streams a JSON or JSON Lines file through the parser and
+//   straight back out through a JsonWriter.  Nothing is built up in memory,
+//   so files larger than RAM go through in a few megabytes.
+//
+//   json-reformat [options] [input [output]]
+//
+//     --compact            no whitespace (the default)
+//     --pretty[=N]         one element per line, N spaces of indent (2)
+//     --tabs               one element per line, a tab of indent per level
+//     --lines              input is JSON Lines; output one document per line
+//     --drop KEY           leave out every field named KEY, at any depth
+//     --rename OLD=NEW     write every field named OLD as NEW
+//     --quiet              don't report throughput and memory use
+//
+//   input and output default to stdin and stdout; "-" means the same.
+//   Throughput and peak RSS are reported on stderr.
+//
+// Build against the library, for example:
+//   g++ -O2 -std=c++11 -I<pkg include dir> JsonReformat.cpp
+//     <csaru-json-cpp sources or library> -pthread -o json-reformat
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+#include <csaru-json-cpp/JsonOutput.hpp>
+#include <csaru-json-cpp/JsonParser.hpp>
+#include <csaru-json-cpp/JsonWriter.hpp>
+
+#if _MSC_VER > 1000
+    #pragma warning(push)
+    // unsafe functions warning, such as fopen()
+    #pragma warning(disable:4996)
+#endif
+
+namespace {
+
+//=========================================================================
+// Sits between the parser and the writer, dropping and renaming fields.
+class Filter : public CSaruJson::JsonParser::CallbackInterface {
+private:
+    // Data
+    CSaruJson::JsonParser *  m_parser;
+    CSaruJson::JsonWriter *  m_writer;
+    std::vector<std::string> m_drops;
+    std::vector<std::pair<std::string, std::string>> m_renames;
+    // true for each open object, false for each open array
+    std::vector<bool>        m_containers;
+    // a dropped container is being skipped; its end is still to come
+    bool                     m_swallowEnd;
+
+    // Helpers
+    static bool Matches (const std::string & key, const char * name, std::size_t nameLen) {
+        return key.size() == nameLen && std::memcmp(key.data(), name, nameLen) == 0;
+    }
+
+    // RETURN: false if the field should be dropped.  Otherwise name and
+    //   nameLen are what to write it as.
+    bool Field (const char ** name, std::size_t * nameLen) {
+        // names only mean something inside objects
+        if (m_containers.empty() || !m_containers.back())
+            return true;
+
+        for (const std::string & drop : m_drops) {
+            if (Matches(drop, *name, *nameLen))
+                return false;
+        }
+        for (const std::pair<std::string, std::string> & rename : m_renames) {
+            if (Matches(rename.first, *name, *nameLen)) {
+                *name    = rename.second.data();
+                *nameLen = rename.second.size();
+                break;
+            }
+        }
+        return true;
+    }
+
+    // RETURN: false if the container is dropped, and being skipped.
+    bool BeginContainer (const char ** name, std::size_t * nameLen, bool isObject) {
+        if (!Field(name, nameLen)) {
+            m_parser->SkipContainer();
+            m_swallowEnd = true;
+            return false;
+        }
+        m_containers.push_back(isObject);
+        return true;
+    }
+
+    // RETURN: false if this is the end of a dropped container.
+    bool EndContainer () {
+        if (m_swallowEnd) {
+            m_swallowEnd = false;
+            return false;
+        }
+        m_containers.pop_back();
+        return true;
+    }
+
+public:
+    // Methods
+    Filter (CSaruJson::JsonParser * parser, CSaruJson::JsonWriter * writer)
+        : m_parser(parser)
+        , m_writer(writer)
+        , m_swallowEnd(false)
+    {}
+
+    void Drop (const char * key) {
+        m_drops.push_back(key);
+    }
+
+    void Rename (const char * from, const char * to) {
+        m_renames.push_back(std::make_pair(std::string(from), std::string(to)));
+    }
+
+    // CallbackInterface implementations
+    virtual void BeginObject (const char * name, std::size_t nameLen) {
+        if (BeginContainer(&name, &nameLen, true))
+            m_writer->BeginObject(name, nameLen);
+    }
+    virtual void EndObject () {
+        if (EndContainer())
+            m_writer->EndObject();
+    }
+    virtual void BeginArray (const char * name, std::size_t nameLen) {
+        if (BeginContainer(&name, &nameLen, false))
+            m_writer->BeginArray(name, nameLen);
+    }
+    virtual void EndArray () {
+        if (EndContainer())
+            m_writer->EndArray();
+    }
+    virtual void GotString (const char * name, std::size_t nameLen, const char * value, std::size_t valueLen) {
+        if (Field(&name, &nameLen))
+            m_writer->GotString(name, nameLen, value, valueLen);
+    }
+    virtual void GotStringSpan (
+        const char * name,
+        std::size_t  nameLen,
+        const char * value,
+        std::size_t  valueLen,
+        bool         valueHasEscapes
+    ) {
+        if (Field(&name, &nameLen))
+            m_writer->GotStringSpan(name, nameLen, value, valueLen, valueHasEscapes);
+    }
+    virtual void GotFloat (const char * name, std::size_t nameLen, float value) {
+        if (Field(&name, &nameLen))
+            m_writer->GotFloat(name, nameLen, value);
+    }
+    virtual void GotInteger (const char * name, std::size_t nameLen, int value) {
+        if (Field(&name, &nameLen))
+            m_writer->GotInteger(name, nameLen, value);
+    }
+    virtual void GotNumberRaw (
+        const char *                          name,
+        std::size_t                           nameLen,
+        const char *                          text,
+        std::size_t                           textLen,
+        CSaruJson::JsonParser::NumberKind     kind
+    ) {
+        if (Field(&name, &nameLen))
+            m_writer->GotNumberRaw(name, nameLen, text, textLen, kind);
+    }
+    virtual void GotBoolean (const char * name, std::size_t nameLen, bool value) {
+        if (Field(&name, &nameLen))
+            m_writer->GotBoolean(name, nameLen, value);
+    }
+    virtual void GotNull (const char * name, std::size_t nameLen) {
+        if (Field(&name, &nameLen))
+            m_writer->GotNull(name, nameLen);
+    }
+    virtual void EndDocument () {
+        m_writer->EndDocument();
+    }
+    virtual void SkippedDocument (CSaruJson::JsonParser::ErrorStatus error, std::size_t row, std::size_t column) {
+        m_containers.clear();
+        m_swallowEnd = false;
+        m_writer->SkippedDocument(error, row, column);
+    }
+};
+
+//=========================================================================
+// RETURN: Peak resident set size in bytes, or 0 if unknown.
+std::size_t PeakResidentBytes () {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    #ifdef __APPLE__
+        return std::size_t(usage.ru_maxrss);
+    #else
+        return std::size_t(usage.ru_maxrss) * 1024;
+    #endif
+#endif
+}
+
+//=========================================================================
+int Usage () {
+    std::fprintf(
+        stderr,
+        "usage: json-reformat [--compact | --pretty[=N] | --tabs] [--lines]\n"
+        "                     [--drop KEY]... [--rename OLD=NEW]... [--quiet]\n"
+        "                     [input [output]]\n"
+    );
+    return 2;
+}
+
+} // namespace
+
+//=========================================================================
+int main (int argc, char ** argv) {
+    using Clock = std::chrono::steady_clock;
+
+    CSaruJson::JsonFormat format = CSaruJson::JsonFormat::Compact();
+    bool                  lines  = false;
+    bool                  quiet  = false;
+    const char *          inputPath  = nullptr;
+    const char *          outputPath = nullptr;
+    std::vector<const char *>                              drops;
+    std::vector<std::pair<std::string, std::string>>      renames;
+
+    for (int i = 1;  i < argc;  ++i) {
+        const char * arg = argv[i];
+        if (std::strcmp(arg, "--compact") == 0)
+            format = CSaruJson::JsonFormat::Compact();
+        else if (std::strcmp(arg, "--pretty") == 0)
+            format = CSaruJson::JsonFormat::Pretty(2);
+        else if (std::strncmp(arg, "--pretty=", 9) == 0)
+            format = CSaruJson::JsonFormat::Pretty(std::atoi(arg + 9));
+        else if (std::strcmp(arg, "--tabs") == 0)
+            format = CSaruJson::JsonFormat::Pretty(1, '\t');
+        else if (std::strcmp(arg, "--lines") == 0)
+            lines = true;
+        else if (std::strcmp(arg, "--quiet") == 0)
+            quiet = true;
+        else if (std::strcmp(arg, "--drop") == 0 && i + 1 < argc)
+            drops.push_back(argv[++i]);
+        else if (std::strcmp(arg, "--rename") == 0 && i + 1 < argc) {
+            const char * rename    = argv[++i];
+            const char * separator = std::strchr(rename, '=');
+            if (separator == nullptr || separator == rename)
+                return Usage();
+            renames.push_back(std::make_pair(std::string(rename, separator), std::string(separator + 1)));
+        }
+        else if (arg[0] == '-' && arg[1] != '\0')
+            return Usage();
+        else if (inputPath == nullptr)
+            inputPath = arg;
+        else if (outputPath == nullptr)
+            outputPath = arg;
+        else
+            return Usage();
+    }
+
+    const bool   stdinInput  = inputPath == nullptr || std::strcmp(inputPath, "-") == 0;
+    const bool   stdoutOutput = outputPath == nullptr || std::strcmp(outputPath, "-") == 0;
+    std::FILE *  input  = stdinInput ? stdin : std::fopen(inputPath, "rb");
+    if (input == nullptr) {
+        std::fprintf(stderr, "json-reformat: can't open %s\n", inputPath);
+        return 1;
+    }
+    std::FILE *  output = stdoutOutput ? stdout : std::fopen(outputPath, "wb");
+    if (output == nullptr) {
+        std::fprintf(stderr, "json-reformat: can't create %s\n", outputPath);
+        return 1;
+    }
+
+    const auto start = Clock::now();
+
+    CSaruJson::JsonParser     parser;
+    CSaruJson::JsonFileOutput fileOutput(output);
+    CSaruJson::JsonWriter     writer(&fileOutput, format);
+    Filter                    filter(&parser, &writer);
+    for (const char * drop : drops)
+        filter.Drop(drop);
+    for (const std::pair<std::string, std::string> & rename : renames)
+        filter.Rename(rename.first.c_str(), rename.second.c_str());
+
+    // Text goes from the read buffer to the output untouched wherever it
+    //   can: numbers as written, strings without escapes without a copy.
+    parser.SetZeroCopy(true);
+    parser.SetDeferredNumbers(true);
+    parser.SetStructuralIndexing(true);
+    parser.SetMultipleDocuments(lines);
+    parser.SetReadAhead(4);
+
+    const bool parsed  = parser.ParseEntireFile(input, nullptr, 0, &filter);
+    const bool written = fileOutput.Flush() && std::fflush(output) == 0;
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    // only a seekable input knows how much was read
+    const long inputSize = std::ftell(input);
+    if (!stdinInput)
+        std::fclose(input);
+    if (!stdoutOutput && std::fclose(output) != 0)
+        return 1;
+
+    if (!parsed) {
+        // the parse stopped at the error, so its position is still to hand
+        const CSaruJson::JsonParser::ParseError & error = parser.GetError();
+        std::size_t row, column;
+        parser.GetPosition(&row, &column);
+        std::fprintf(
+            stderr,
+            "json-reformat: %s:%zu:%zu (byte %zu): %s\n",
+            stdinInput ? "<stdin>" : inputPath,
+            row,
+            column,
+            error.offset,
+            error.message
+        );
+        return 1;
+    }
+    if (!written || writer.GetErrorStatus() != CSaruJson::JsonWriter::ErrorStatus::None) {
+        std::fprintf(stderr, "json-reformat: failed writing output\n");
+        return 1;
+    }
+
+    if (!quiet) {
+        if (inputSize > 0) {
+            std::fprintf(
+                stderr,
+                "json-reformat: %ld bytes in %.3f s, %.1f MB/s, peak RSS %.1f MB\n",
+                inputSize,
+                elapsed.count(),
+                double(inputSize) / elapsed.count() / (1024.0 * 1024.0),
+                double(PeakResidentBytes()) / (1024.0 * 1024.0)
+            );
+        }
+        else {
+            std::fprintf(
+                stderr,
+                "json-reformat: %.3f s, peak RSS %.1f MB\n",
+                elapsed.count(),
+                double(PeakResidentBytes()) / (1024.0 * 1024.0)
+            );
+        }
+    }
+
+    return 0;
+}
+
+#if _MSC_VER > 1000
+    #pragma warning(pop)
+#endif